@@ -36,6 +36,16 @@
 #ifndef __m8_h__
 #define __m8_h__
 
+// Strict modes (e.g. `-std=c99`) hide POSIX declarations, so they are requested before any system header.
+#ifndef _WIN32
+  #ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+  #endif
+  #if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+  #endif
+#endif
+
 #include <stdbool.h>
 #include <assert.h>
 #include <stddef.h>
@@ -63,7 +73,19 @@
   #define mkdir(path, __) (CreateDirectory(path, NULL) == TRUE ? 0 : -1)
 #else
   #include <sys/stat.h>
+  #include <sys/wait.h>
   #include <pthread.h>
+  #include <unistd.h>
+  #include <signal.h>
+  #include <fcntl.h>
+  #include <dirent.h>
+  #include <time.h>
+
+  #ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <sys/ioctl.h>
+  #endif
 
   #define thread_return_t void*
   typedef void* thread_arg_t;
@@ -99,11 +121,34 @@ static char* output = "output"_executable;
 static char* install_prefix = "/usr";
 static char* objects = "o";
 static char* ar = "ar";
+static char* objdump = "objdump";
+static char* gcov = "gcov", *gcov_tool = "gcov-tool";
 
 // If this project is a libray, user may want to export headers as well.
 static size_t header_files_count = 0;
 static char** header_files = NULL;
 
+// Directory for cached results. Defaults to `build_dir`, may point to a shared location to reuse results between checkouts.
+static char* cache_dir = NULL;
+
+// Record files opened by `m8_command` jobs and use them as discovered dependencies. Supported on Linux only.
+static bool trace_commands = false;
+
+// Maximum number of sources passed to a single compiler process, values below 2 disable batching.
+static size_t batch_size = 0;
+// Batches are filled up to this historical compile time in milliseconds, slower sources are compiled alone.
+static unsigned long long batch_cost = 250;
+
+// Program launched by `run` when the project is a library (e.g. a host executable which loads it).
+static char* run_command = NULL;
+
+#ifndef _WIN32
+  // Signal sent to the running program after `run --reload` swapped a shared library.
+  static int reload_signal = SIGHUP;
+  // Source files polling interval in milliseconds for `run --reload`.
+  static long reload_interval = 500;
+#endif
+
 typedef enum __project_type_t {
   PROJECT_TYPE_EXECUTABLE,
   PROJECT_TYPE_STATIC_LIBRARY,
@@ -113,6 +158,69 @@ typedef enum __project_type_t {
 static project_type_t project_type = PROJECT_TYPE_EXECUTABLE;
 
 
+typedef struct __m8_test_t {
+  const char* executable;         // Test binary path, relative to `dist_dir` (e.g. "bin/test").
+  const char* arguments;          // Optional command line arguments.
+  size_t data_files_count;        // Files the test reads. Their contents are a part of the cache key.
+  const char* const* data_files;
+} m8_test_t;
+
+// Tests executed by the `test` command.
+static size_t tests_count = 0;
+static m8_test_t* tests = NULL;
+
+// Names of environment variables which affect test results.
+static size_t test_environment_count = 0;
+static char** test_environment = NULL;
+
+// Benchmarks executed by the `bench` command. Data files are not used.
+static size_t benchmarks_count = 0;
+static m8_test_t* benchmarks = NULL;
+
+
+#ifdef __linux__
+typedef struct __m8_counter_t {
+  const char* name;
+  unsigned int type;              // `PERF_TYPE_*`.
+  unsigned long long config;      // `PERF_COUNT_*`.
+} m8_counter_t;
+
+static const m8_counter_t __hardware_counters[] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+// Used when hardware counters are not available (e.g. in virtual machines).
+static const m8_counter_t __software_counters[] = {
+  { "task-clock-ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+  { "page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+  { "context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+};
+#endif
+
+
+typedef struct __m8_cache_t {
+  char* path;
+  size_t count, capacity;
+  char** keys;
+  unsigned long long* values;
+} m8_cache_t;
+
+#define __hash_seed 14695981039346656037ULL
+
+
+typedef struct __m8_command_t {
+  const char* name;               // Unique job name, used to store discovered dependencies.
+  const char* command;            // Shell command to execute.
+  size_t inputs_count;            // Declared input files.
+  const char* const* inputs;
+  size_t outputs_count;           // Declared output files. The job is rerun if any of them is missing.
+  const char* const* outputs;
+} m8_command_t;
+
+
 typedef int(*build_command_function_t)(const int, const char* const[], const int, const char* const[]);
 
 typedef struct __build_command_t {
@@ -206,13 +314,152 @@ static int m8_uninstall(const int argc, const char* const argv[], const int srcc
 static int m8_clean(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
 
 
+/* * *
+ * Default test function. Runs declared tests, skipping the ones which passed with the same inputs before.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero if all tests passed.
+ */
+static int m8_test(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default check function. Runs changed sources through the compiler with `-fsyntax-only`.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero if all sources passed the check.
+ */
+static int m8_check(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default run function. Builds and launches the project, optionally reloading a shared library on changes.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns program exit status.
+ */
+static int m8_run(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default asm function. Recompiles a single source with build flags and prints its annotated disassembly.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero on success.
+ */
+static int m8_asm(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default coverage function. Builds an instrumented variant, runs tests in parallel and summarizes coverage.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero if the report was produced and all tests passed.
+ */
+static int m8_coverage(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default bench function. Runs declared benchmarks, reporting wall time and performance counters
+ * compared to the previous run.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero if all benchmarks succeeded.
+ */
+static int m8_bench(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default delta function. Produces binary patches for every changed file between two dist trees.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero on success.
+ */
+static int m8_delta(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
+/* * *
+ * Default patch function. Applies patches produced by `delta` to a dist tree, verifying hashes.
+ *
+ * Arguments:
+ * - argc - command line arguments count.
+ * - argv - command line arguments.
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns zero on success.
+ */
+static int m8_patch(const int argc, const char* const argv[], const int srcc, const char* const srcv[]);
+
+
 typedef struct __m8_compilation_list_t {
   size_t count;
   char** srcv;
   char** objv;
+  int* statusv;                 // Optional per-source exit statuses.
+  unsigned long long* timev;    // Optional per-source durations in milliseconds: historical on input, measured on output.
+  size_t slot;                  // Job slot (thread) index.
 } m8_compilation_list_t;
 
 
+#ifdef __linux__
+typedef struct __m8_job_slot_t {
+  const char* source;           // Source being compiled, NULL if the slot is idle.
+  double started;               // Start time, see `__now`.
+  double expected;              // Historical duration in seconds, zero if unknown.
+  pid_t pid;                    // Compiler process.
+} m8_job_slot_t;
+
+// Shared state of the live jobs view (`build --top`). Workers only touch it under the lock.
+typedef struct __m8_monitor_t {
+  pthread_mutex_t lock;
+  bool running;
+  m8_job_slot_t* slots;
+  size_t slots_count;
+  char** srcv;                  // Build sources, used to map slot sources to historical durations.
+  double* expected;             // Historical durations in seconds per source, zero if unknown.
+  size_t total, done, started_count, pending_unknown;
+  double started, done_time, pending_expected;
+} m8_monitor_t;
+
+static m8_monitor_t __monitor = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+// Process snapshot entry of the live jobs view, read from `/proc/<pid>/stat`.
+typedef struct __m8_process_t {
+  pid_t pid, parent;
+  unsigned long ticks;          // User and system CPU time in clock ticks.
+  long pages;                   // Resident set size in pages.
+} m8_process_t;
+#endif
+
+
 /* * *
  * Convert a list of source files into target files.
  *
@@ -223,6 +470,149 @@ typedef struct __m8_compilation_list_t {
 static thread_return_t m8_compile(const thread_arg_t data);
 
 
+/* * *
+ * Check syntax of a list of source files. Unlike `m8_compile`, does not stop on the first failure.
+ *
+ * Arguments:
+ * - data - instance of `m8_compilation_list_t`, `objv` holds dependency files paths;
+ * Returns zero.
+ */
+static thread_return_t m8_syntax_check(const thread_arg_t data);
+
+
+/* * *
+ * Execute a list of shell commands, recording their statuses.
+ *
+ * Arguments:
+ * - data - instance of `m8_compilation_list_t`, `srcv` holds commands;
+ * Returns zero.
+ */
+static thread_return_t __execute_commands(const thread_arg_t data);
+
+
+#ifndef _WIN32
+/* * *
+ * Find the end of a batch of small sources, starting at `begin`. Sources with the same file name
+ * never share a batch, as the compiler names objects after them.
+ *
+ * Arguments:
+ * - list  - compilation list with historical durations.
+ * - begin - first source index.
+ * Returns index past the last source of the batch.
+ */
+static size_t __get_batch_end(const m8_compilation_list_t* const list, const size_t begin);
+
+
+/* * *
+ * Compile a batch of sources with a single compiler process in `<build_dir>/batch.<slot>` and move
+ * objects (and dependency files, if any) to their places.
+ *
+ * Arguments:
+ * - list      - compilation list.
+ * - begin     - first source index.
+ * - end       - index past the last source.
+ * - arguments - compiler arguments with absolute include paths.
+ * Returns true if every object was produced.
+ */
+static bool __compile_batch(const m8_compilation_list_t* const list, const size_t begin, const size_t end, const char* const arguments);
+
+
+/* * *
+ * Make relative paths in include-related compiler options (`-I`, `-isystem`, `-include`, ...) absolute.
+ *
+ * Arguments:
+ * - arguments - compiler arguments.
+ * Returns rewritten arguments. Must be freed.
+ */
+static char* __absolute_arguments(const char* const arguments);
+
+
+/* * *
+ * Collect regular files of a directory tree.
+ *
+ * Arguments:
+ * - root     - tree root.
+ * - relative - subdirectory to scan, relative to `root`, empty string for the root itself.
+ * - files    - output set, keys are `root`-relative paths, values are file modes.
+ */
+static void __list_files(const char* const root, const char* const relative, m8_cache_t* const files);
+
+
+/* * *
+ * Create all parent directories of a file.
+ *
+ * Arguments:
+ * - path - file path.
+ */
+static void __make_parents(const char* const path);
+
+
+/* * *
+ * Check that a path stays inside the directory it is joined to.
+ *
+ * Arguments:
+ * - path - relative path.
+ * Returns false for empty and absolute paths and for paths with `..` components.
+ */
+static bool __is_contained_path(const char* const path);
+
+
+/* * *
+ * Read a whole file into memory.
+ *
+ * Arguments:
+ * - path - file path.
+ * - size - output file size.
+ * Returns file contents or NULL. Must be freed.
+ */
+static unsigned char* __read_file(const char* const path, size_t* const size);
+
+
+/* * *
+ * Write a binary delta between two buffers. Blocks of the old buffer are indexed by a rolling hash,
+ * then the new buffer is scanned for them, emitting copies of matched ranges and inserts of the rest.
+ *
+ * Arguments:
+ * - file     - output file.
+ * - old      - old contents.
+ * - old_size - old contents size.
+ * - new      - new contents.
+ * - new_size - new contents size.
+ * Returns zero on success.
+ */
+static int __write_delta(
+  FILE* const file,
+  const unsigned char* const old,
+  const size_t old_size,
+  const unsigned char* const new,
+  const size_t new_size
+);
+
+
+/* * *
+ * Apply a binary delta, verifying the old and the new contents hashes.
+ *
+ * Arguments:
+ * - file     - delta file.
+ * - old      - old contents.
+ * - old_size - old contents size.
+ * - new_size - output new contents size.
+ * Returns new contents or NULL on a malformed delta or hash mismatch. Must be freed.
+ */
+static unsigned char* __apply_delta(FILE* const file, const unsigned char* const old, const size_t old_size, size_t* const new_size);
+
+
+/* * *
+ * Generate deltas for a list of files. Roots are taken from `__delta_roots`.
+ *
+ * Arguments:
+ * - data - instance of `m8_compilation_list_t`, `srcv` holds relative paths, `objv` holds delta paths;
+ * Returns zero.
+ */
+static thread_return_t __generate_deltas(const thread_arg_t data);
+#endif
+
+
 /* * *
  * Perform object linkage.
  *
@@ -234,6 +624,19 @@ static thread_return_t m8_compile(const thread_arg_t data);
 static int m8_link(const int objc, const char* const objv[]);
 
 
+/* * *
+ * Run a custom job (generator, script, etc.) from a user build command. The job is skipped if its
+ * outputs exist and neither the command, nor declared or discovered inputs changed since the last success.
+ * With `trace_commands` set, files opened by the job are recorded as discovered inputs, and undeclared
+ * inputs and outputs are reported.
+ *
+ * Arguments:
+ * - command - job description.
+ * Returns job exit status, zero if skipped.
+ */
+static inline int m8_command(const m8_command_t* const command);
+
+
 /* * *
  * Construct a list of object files from source files.
  *
@@ -245,6 +648,52 @@ static int m8_link(const int objc, const char* const objv[]);
 static char** __get_object_files(const int srcc, const char* const srcv[]);
 
 
+/* * *
+ * Construct a list of files in `build_dir` from source files.
+ *
+ * Arguments:
+ * - srcc      - source files paths count.
+ * - srcv      - source files paths.
+ * - extension - extension to append (e.g. `o`).
+ * Returns a list of build files paths. Must be freed with `__free_object_files`.
+ */
+static char** __get_build_files(const int srcc, const char* const srcv[], const char* const extension);
+
+
+/* * *
+ * Split source files between threads and run a function on every part.
+ *
+ * Arguments:
+ * - jobs     - number of threads to use.
+ * - count    - source files count.
+ * - srcv     - source files.
+ * - objv     - target files, one per source.
+ * - statusv  - optional per-source statuses.
+ * - timev    - optional per-source durations.
+ * - function - function to execute on each `m8_compilation_list_t`.
+ */
+static void __run_jobs(
+  const int jobs,
+  const size_t count,
+  char** const srcv,
+  char** const objv,
+  int* const statusv,
+  unsigned long long* const timev,
+  thread_return_t(*function)(thread_arg_t)
+);
+
+
+/* * *
+ * Mix all dependencies, listed in a Makefile-style dependency file, into a hash.
+ *
+ * Arguments:
+ * - hash    - pointer to the current hash value, updated in place.
+ * - depfile - dependency file path.
+ * Returns false if the dependency file or any dependency can not be read.
+ */
+static bool __hash_depfile(unsigned long long* const hash, const char* const depfile);
+
+
 /* * *
  * Free the memory, allocated for object files list.
  *
@@ -281,6 +730,16 @@ static void __setup_tree(void);
 static int __get_jobs(const int argc, const char* const argv[]);
 
 
+/* * *
+ * Decode a `system` or `waitpid` status.
+ *
+ * Arguments:
+ * - status - raw status.
+ * Returns process exit code, or 1 if it did not exit normally.
+ */
+static int __exit_code(const int status);
+
+
 /* * *
  * Create and run a thread.
  *
@@ -320,37 +779,418 @@ static char* __get_target_path(void);
 static inline int __copy(const char* const source, const char* const destanation);
 
 
-static build_command_t default_build_commands[] = {
-  {
-    .name = "build",
-    .description = "Compile and link source files."
-                   "Add `j N` or `--jobs N` options, where N is a number of threads to utilize.",
-    .function = &m8_build
-  },
-#ifndef _WIN32
-  {
-    .name = "install",
-    .description = "Copy a dist tree to a specified directory.",
-    .function = &m8_install
-  },
-  {
-    .name = "uninstall",
-    .description = "Remove all installed files.",
-    .function = &m8_uninstall
-  },
-#endif
-  {
-    .name = "clean",
-    .description = "Remove all temporary build files and dist tree.",
-    .function = &m8_clean
-  },
-};
+/* * *
+ * Remove a directory with all its contents.
+ *
+ * Arguments:
+ * - path - directory to remove.
+ * Returns zero on success.
+ */
+static inline int __remove_tree(const char* const path);
 
 
-static int m8_main(
-  const int argc,
-  const char* const argv[],
-  const int srcc,
+#ifndef _WIN32
+/* * *
+ * Merge coverage profile trees pairwise with `gcov_tool`. Every round runs in parallel.
+ *
+ * Arguments:
+ * - jobs        - number of threads to use.
+ * - count       - profile trees count.
+ * - directories - profile trees, freed by this function.
+ * Returns merged profile tree path or NULL on failure. Must be freed.
+ */
+static char* __merge_profiles(const int jobs, size_t count, char** const directories);
+
+
+/* * *
+ * Summarize line and branch coverage with `gcov` and print a report. Sources, whose notes and
+ * counters did not change since the last run, reuse the cached summaries.
+ *
+ * Arguments:
+ * - jobs       - number of threads to use.
+ * - srcc       - source files count.
+ * - srcv       - source files.
+ * - data_files - counter files (`.gcda`) paths in `build_dir`, one per source.
+ * - profile    - merged profile tree.
+ * Returns zero on success.
+ */
+static int __report_coverage(
+  const int jobs,
+  const int srcc,
+  const char* const srcv[],
+  char** const data_files,
+  const char* const profile
+);
+
+
+/* * *
+ * Mix a gcov notes or counters file into a hash, skipping the header. The header holds a stamp,
+ * which changes on every compilation even if the source did not.
+ *
+ * Arguments:
+ * - hash - pointer to the current hash value, updated in place.
+ * - path - `.gcno` or `.gcda` file path.
+ * Returns false if the file can not be read.
+ */
+static bool __hash_gcov_file(unsigned long long* const hash, const char* const path);
+
+
+/* * *
+ * Format a coverage ratio as `hit/total percent`, with `n/a` instead of a percent if there is nothing to cover.
+ *
+ * Arguments:
+ * - buffer - output buffer, at least 32 bytes.
+ * - hit    - covered items count.
+ * - total  - all items count.
+ * Returns `buffer`.
+ */
+static char* __format_coverage(char* const buffer, const unsigned long long hit, const unsigned long long total);
+#endif
+
+
+#ifdef __linux__
+/* * *
+ * Open a performance counter.
+ *
+ * Arguments:
+ * - counter - counter description.
+ * - pid     - process to measure, zero for the calling one. Children are measured as well.
+ * - exec    - enable the counter when the process calls `exec`.
+ * Returns counter file descriptor, negative on failure.
+ */
+static int __open_counter(const m8_counter_t* const counter, const pid_t pid, const bool exec);
+
+
+/* * *
+ * Run a shell command, measuring its wall time and performance counters.
+ *
+ * Arguments:
+ * - command  - shell command.
+ * - counters - counters to collect.
+ * - count    - counters count.
+ * - values   - collected values, `~0ULL` for counters which failed to open.
+ * - seconds  - wall time.
+ * Returns command exit status in `system` format.
+ */
+static int __run_measured(
+  const char* const command,
+  const m8_counter_t* const counters,
+  const size_t count,
+  unsigned long long* const values,
+  double* const seconds
+);
+#endif
+
+
+/* * *
+ * Check whether an option is present in the command line.
+ *
+ * Arguments:
+ * - argc   - command line arguments count.
+ * - argv   - command line arguments.
+ * - option - option to look for (e.g. `--force`).
+ * Returns true if the option is present.
+ */
+static bool __has_option(const int argc, const char* const argv[], const char* const option);
+
+
+/* * *
+ * Mix a memory block into a FNV-1a hash.
+ *
+ * Arguments:
+ * - hash - current hash value, `__hash_seed` to start a new one.
+ * - data - memory block.
+ * - size - memory block size.
+ * Returns updated hash.
+ */
+static unsigned long long __hash_bytes(unsigned long long hash, const void* const data, const size_t size);
+
+
+/* * *
+ * Mix a null-terminated string (including terminator) into a hash.
+ *
+ * Arguments:
+ * - hash   - current hash value.
+ * - string - string to mix in.
+ * Returns updated hash.
+ */
+static unsigned long long __hash_string(const unsigned long long hash, const char* const string);
+
+
+/* * *
+ * Mix file contents into a hash. Missing files are mixed in as a marker.
+ *
+ * Arguments:
+ * - hash - pointer to the current hash value, updated in place.
+ * - path - file path.
+ * Returns false if the file can not be read.
+ */
+static bool __hash_file(unsigned long long* const hash, const char* const path);
+
+
+/* * *
+ * Load a key-value cache from `cache_dir`. Missing cache is loaded as empty.
+ *
+ * Arguments:
+ * - name - cache name, stored as `<cache_dir>/<name>.m8cache`.
+ * Returns loaded cache. Must be freed with `__cache_free`.
+ */
+static m8_cache_t __cache_load(const char* const name);
+
+
+/* * *
+ * Look up a cached value.
+ *
+ * Arguments:
+ * - cache - loaded cache.
+ * - key   - entry key.
+ * - value - output value, untouched if the key is missing.
+ * Returns true if the key is present.
+ */
+static bool __cache_get(const m8_cache_t* const cache, const char* const key, unsigned long long* const value);
+
+
+/* * *
+ * Insert or update a cached value.
+ *
+ * Arguments:
+ * - cache - loaded cache.
+ * - key   - entry key. Must not contain line breaks.
+ * - value - value to store.
+ */
+static void __cache_set(m8_cache_t* const cache, const char* const key, const unsigned long long value);
+
+
+/* * *
+ * Write cache back to the disk.
+ *
+ * Arguments:
+ * - cache - loaded cache.
+ * Returns zero on success.
+ */
+static int __cache_save(const m8_cache_t* const cache);
+
+
+/* * *
+ * Free the memory, allocated for a cache.
+ *
+ * Arguments:
+ * - cache - loaded cache.
+ */
+static void __cache_free(m8_cache_t* const cache);
+
+
+/* * *
+ * Execute a shell command, recording every file it opens to a trace file. Builds a preloaded tracing
+ * library in `build_dir` on the first use.
+ *
+ * Arguments:
+ * - command - shell command.
+ * - trace   - trace file path. Each line is `R <absolute path>` or `W <absolute path>`.
+ * Returns command exit status.
+ */
+static int __execute_traced(const char* const command, const char* const trace);
+
+
+/* * *
+ * Load a trace file into a set of project files. Files outside of the project tree and directories are skipped.
+ *
+ * Arguments:
+ * - trace - trace file path.
+ * - files - output set, keys are project-relative paths, values are `1` for reads, `2` for writes or both.
+ * Returns false if the trace can not be read.
+ */
+static bool __read_trace(const char* const trace, m8_cache_t* const files);
+
+
+#ifndef _WIN32
+/* * *
+ * Hash modification times and sizes of sources and exported headers. Used to detect changes without reading files.
+ *
+ * Arguments:
+ * - srcc - source files count.
+ * - srcv - source files.
+ * Returns sources state hash.
+ */
+static unsigned long long __hash_sources_state(const int srcc, const char* const srcv[]);
+#endif
+
+
+/* * *
+ * Get a monotonic timestamp.
+ * Returns time in seconds since an unspecified point.
+ */
+static double __now(void);
+
+
+/* * *
+ * Print file contents to the standard output.
+ *
+ * Arguments:
+ * - path - file to print.
+ * Returns true if anything was printed.
+ */
+static bool __print_file(const char* const path);
+
+
+#ifndef _WIN32
+/* * *
+ * Compile a source file with debug information and disassemble it, interleaving source lines.
+ *
+ * Arguments:
+ * - source    - source file, relative to `source_dir`.
+ * - arguments - compiler arguments to use instead of `compiler_arguments`.
+ * - symbol    - function to print, NULL to print all functions.
+ * - object    - temporary object file path.
+ * - count     - output lines count.
+ * Returns a list of lines with tabs expanded, NULL if compilation failed. Must be freed with `__free_object_files`.
+ */
+static char** __disassemble(
+  const char* const source,
+  const char* const arguments,
+  const char* const symbol,
+  const char* const object,
+  size_t* const count
+);
+#endif
+
+
+#ifdef __linux__
+/* * *
+ * Prepare the live jobs view state.
+ *
+ * Arguments:
+ * - jobs  - job slots count.
+ * - srcc  - source files count.
+ * - srcv  - source files.
+ * - times - historical durations cache, milliseconds per source.
+ */
+static void __start_monitor(const int jobs, const int srcc, char** const srcv, const m8_cache_t* const times);
+
+
+/* * *
+ * Free the live jobs view state. The view thread must be stopped.
+ */
+static void __stop_monitor(void);
+
+
+/* * *
+ * Live jobs view thread. Redraws job slots, queue depth and ETA until `__monitor.running` is cleared.
+ *
+ * Arguments:
+ * - data - unused.
+ * Returns zero.
+ */
+static thread_return_t __monitor_jobs(const thread_arg_t data);
+
+
+/* * *
+ * Order processes by pid, `qsort` and `bsearch` comparator.
+ *
+ * Arguments:
+ * - left  - instance of `m8_process_t`.
+ * - right - instance of `m8_process_t`.
+ * Returns negative, zero or positive value.
+ */
+static int __compare_processes(const void* const left, const void* const right);
+
+
+/* * *
+ * Execute a compiler command in a job slot, redirecting its output to `<object>.log`.
+ *
+ * Arguments:
+ * - command - shell command.
+ * - object  - object file path, used for the log name.
+ * - source  - source file, shown in the view.
+ * - slot    - job slot index.
+ * Returns command exit status in `system` format.
+ */
+static int __execute_job(const char* const command, const char* const object, const char* const source, const size_t slot);
+#endif
+
+
+static build_command_t default_build_commands[] = {
+  {
+    .name = "build",
+    .description = "Compile and link source files."
+                   "Add `j N` or `--jobs N` options, where N is a number of threads to utilize. "
+                   "Add `--top` to watch running jobs live.",
+    .function = &m8_build
+  },
+#ifndef _WIN32
+  {
+    .name = "install",
+    .description = "Copy a dist tree to a specified directory.",
+    .function = &m8_install
+  },
+  {
+    .name = "uninstall",
+    .description = "Remove all installed files.",
+    .function = &m8_uninstall
+  },
+  {
+    .name = "coverage",
+    .description = "Build an instrumented variant in `<build_dir>/coverage`, run tests in parallel with separate "
+                   "profiles, merge them and print line and branch coverage. Unchanged sources reuse cached results. "
+                   "Accepts `-j N`.",
+    .function = &m8_coverage
+  },
+  {
+    .name = "bench",
+    .description = "Run declared benchmarks, reporting wall time and hardware counters (software ones if the host "
+                   "has no PMU) with deltas to the previous run. Add `--repeat N` to average N runs (default 5).",
+    .function = &m8_bench
+  },
+  {
+    .name = "delta",
+    .description = "Write binary patches for files changed between two dist trees: "
+                   "`delta <old-dist> <new-dist> [-o <dir>]`, defaults to `<build_dir>/delta`. Accepts `-j N`.",
+    .function = &m8_delta
+  },
+  {
+    .name = "patch",
+    .description = "Apply patches written by `delta` to a dist tree: `patch <dist> <delta-dir>`. "
+                   "All hashes are verified before any file is replaced.",
+    .function = &m8_patch
+  },
+  {
+    .name = "asm",
+    .description = "Print annotated disassembly of a source file: `asm <file> [symbol]`. The file is recompiled "
+                   "with build flags plus `-g`. Add `--compare \"<flags>\"` to show a second flag set side by side.",
+    .function = &m8_asm
+  },
+#endif
+  {
+    .name = "check",
+    .description = "Check syntax of changed source files without generating code. Sources which passed "
+                   "are skipped until they or their headers change. Accepts `-j N` and `--force`.",
+    .function = &m8_check
+  },
+  {
+    .name = "test",
+    .description = "Run declared tests. Tests whose binary, data files and environment did not change since "
+                   "a passing run are reported as cached. Add `--force` to run all tests.",
+    .function = &m8_test
+  },
+  {
+    .name = "run",
+    .description = "Build and launch the project. Arguments after `--` are passed to the program. "
+                   "With `--reload`, a shared library project is rebuilt on source changes, swapped atomically "
+                   "and `run_command` receives `reload_signal` (SIGHUP by default, `--signal N` to override).",
+    .function = &m8_run
+  },
+  {
+    .name = "clean",
+    .description = "Remove all temporary build files and dist tree.",
+    .function = &m8_clean
+  },
+};
+
+
+static int m8_main(
+  const int argc,
+  const char* const argv[],
+  const int srcc,
   const char* const srcv[],
   const int cmdc,
   const build_command_t cmdv[]
@@ -396,37 +1236,73 @@ static int m8_build(const int argc, const char* const argv[], const int srcc, co
   printf("= = = [COMPILING] = = = = = = = = = = = =" _endl);
   const int jobs = __get_jobs(argc, argv);
   const int threads_count = jobs < srcc ? jobs : srcc;
-  const size_t job_sources = srcc / threads_count, remaining_sources = srcc % threads_count;
   printf("[I] Using %d jobs" _endl, threads_count);
 
   __setup_tree();
   char** object_files = __get_object_files(srcc, srcv);
+  m8_cache_t times = __cache_load("times");
+  unsigned long long* durations = (unsigned long long*)calloc(srcc, sizeof *durations);
+  for (size_t index = 0; index < srcc; index++) __cache_get(&times, srcv[index], durations + index);
+  int* statuses = NULL;
+  size_t failed = 0;
+  #ifdef __linux__
+    thread_t monitor;
+    if (__has_option(argc, argv, "--top")) {
+
+      // Failures are collected instead of aborting, so the view is closed before logs are printed.
+      if (isatty(STDOUT_FILENO)) {
+
+        statuses = (int*)calloc(srcc, sizeof *statuses);
+        __start_monitor(threads_count, srcc, (char**)srcv, &times);
+        monitor = __create_thread(&__monitor_jobs, NULL);
+      } else printf("[W] `--top` requires a terminal, ignored." _endl);
+    }
+  #endif
+  __run_jobs(threads_count, srcc, (char**)srcv, object_files, statuses, durations, &m8_compile);
+  #ifdef __linux__
+    if (statuses) {
+
+      pthread_mutex_lock(&__monitor.lock);
+      __monitor.running = false;
+      pthread_mutex_unlock(&__monitor.lock);
+      __wait_jobs(1, &monitor);
+      __stop_monitor();
+      for (size_t index = 0; index < srcc; index++) {
+
+        char log[512] = { 0 };
+        sprintf(log, "%s.log", object_files[index]);
+        if (__print_file(log) || statuses[index]) {
+
+          if (statuses[index]) printf("[E] Compiler returned non-zero value for %s: %d." _endl, srcv[index], statuses[index]);
+          else printf("[I] Above output is from %s." _endl, srcv[index]);
+        }
+        remove(log);
+        failed += statuses[index] != 0;
+      }
+      free(statuses);
+    }
+  #endif
+  for (size_t index = 0; index < srcc; index++) {
 
-  m8_compilation_list_t* lists = (m8_compilation_list_t*)calloc(threads_count, sizeof(m8_compilation_list_t));
-  thread_t* threads = (thread_t*)calloc(threads_count, sizeof (thread_t));
-  for (size_t thread_id = 0; thread_id < threads_count; thread_id++) {
-
-  	lists[thread_id].count = job_sources;
-	lists[thread_id].srcv = (char**)srcv + job_sources * thread_id;
-    lists[thread_id].objv = object_files + job_sources * thread_id;
-    threads[thread_id] = __create_thread(&m8_compile, &lists[thread_id]);
+    if (durations[index]) __cache_set(&times, srcv[index], durations[index]);
   }
-  __wait_jobs(threads_count, threads);
-  free(threads);
-  free(lists);
-
-  if (remaining_sources) {
+  __cache_save(&times);
+  __cache_free(&times);
+  free(durations);
+  if (failed) {
 
-    m8_compilation_list_t remained_list = {
-      .count = remaining_sources,
-      .srcv = (char**)srcv + srcc - remaining_sources,
-      .objv = object_files + srcc - remaining_sources
-    };
-    m8_compile(&remained_list);
+    __free_object_files(srcc, object_files);
+    return 1;
   }
+
   printf("- - - [LINKING] - - - - - - - - - - - - -" _endl);
-  m8_link(srcc, (const char* const*)object_files);
+  const int status = m8_link(srcc, (const char* const*)object_files);
   __free_object_files(srcc, object_files);
+  if (status) {
+
+    printf("[E] Linker returned non-zero value: %d." _endl, __exit_code(status));
+    return 1;
+  }
 
   if (header_files_count) {
 
@@ -505,62 +1381,1311 @@ static int m8_clean(const int argc, const char* const argv[], const int srcc, co
 }
 
 
-static thread_return_t m8_compile(const thread_arg_t data) {
+static int m8_test(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
 
-  const m8_compilation_list_t* const list = (const m8_compilation_list_t*)data;
-  // TODO: Compute the command size.
+  printf("= = = [TEST] = = = = = = = = = = = =" _endl);
+  const bool force = __has_option(argc, argv, "--force");
+  size_t passed = 0, cached = 0, failed = 0;
+  m8_cache_t cache = __cache_load("tests");
   char* command = (char*)malloc(8192);
-  for (size_t index = 0; index < list->count; index++) {
+  for (size_t test_id = 0; test_id < tests_count; test_id++) {
 
-    // TODO: Add formatting options for Windows.
-    const char* format = "%s %s -o %s %s%s%s";
-    sprintf(command, format, compiler, compiler_arguments, list->objv[index], source_dir, __path_delim, list->srcv[index]);
-    printf("[I] Executing (%ld/%ld): %s" _endl, index + 1, list->count, command);
-    const int status = system(command);
-    if (status) {
+    const m8_test_t* const test = tests + test_id;
+    char path[256] = { 0 };
+    sprintf(path, "%s" __path_delim "%s", dist_dir, test->executable);
+    sprintf(command, "%s%s%s", path, test->arguments ? " " : "", test->arguments ? test->arguments : "");
 
-      printf("[E] Compiler returned non-zero value: %d. Aborting." _endl, status);
-      free(command);
-      exit(status);
+    // The key is the command itself, so the same binary may be tested with different arguments.
+    unsigned long long hash = __hash_string(__hash_seed, command), cached_hash = 0;
+    if (!__hash_file(&hash, path)) {
+
+      printf("[E] Test executable not found: %s (%zu/%zu)." _endl, path, test_id + 1, tests_count);
+      failed++;
+      continue;
+    }
+    for (size_t data_file_id = 0; data_file_id < test->data_files_count; data_file_id++) {
+
+      hash = __hash_string(hash, test->data_files[data_file_id]);
+      __hash_file(&hash, test->data_files[data_file_id]);
     }
+    for (size_t variable_id = 0; variable_id < test_environment_count; variable_id++) {
+
+      const char* const value = getenv(test_environment[variable_id]);
+      hash = __hash_string(__hash_string(hash, test_environment[variable_id]), value ? value : "");
+    }
+
+    if (!force && __cache_get(&cache, command, &cached_hash) && cached_hash == hash) {
+
+      printf("[I] Test %s (%zu/%zu)... [CACHED]" _endl, command, test_id + 1, tests_count);
+      cached++;
+      continue;
+    }
+    printf("[I] Executing test (%zu/%zu): %s" _endl, test_id + 1, tests_count, command);
+    fflush(stdout);
+    const int status = system(command);
+    printf("[I] Test %s... %s" _endl, command, status == 0 ? "[OK]" : "[FAILED]");
+    if (status == 0) {
+
+      __cache_set(&cache, command, hash);
+      passed++;
+    } else failed++;
   }
   free(command);
-  return 0;
+  if (__cache_save(&cache)) printf("[E] Unable to save test results to %s." _endl, cache.path);
+  __cache_free(&cache);
+  printf("[I] Tests passed: %zu, cached: %zu, failed: %zu." _endl, passed, cached, failed);
+  return failed ? 1 : 0;
 }
 
 
-static int m8_link(const int objc, const char* const objv[]) {
+static int m8_check(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
 
-  // TODO: Compute the command size.
-  char* command = (char*)malloc(512 + objc * 256);
-  // TODO: Support Windows.
-  if (project_type == PROJECT_TYPE_STATIC_LIBRARY) {
-    sprintf(command, "%s r -o %s", ar, __get_target_path());
-  } else sprintf(command, "%s -o %s", linker, __get_target_path());
-  for (size_t index = 0; index < objc; index++) {
+  printf("= = = [CHECK] = = = = = = = = = = = =" _endl);
+  const bool force = __has_option(argc, argv, "--force");
+  __setup_tree();
+  m8_cache_t cache = __cache_load("check");
+  char** depfiles = __get_build_files(srcc, srcv, "check.d");
+  char** stale_sources = (char**)calloc(srcc, sizeof *stale_sources);
+  char** stale_depfiles = (char**)calloc(srcc, sizeof *stale_depfiles);
+  size_t stale_count = 0;
+
+  // Flags are a part of the hash, so changing them rechecks everything.
+  const unsigned long long flags_hash = __hash_string(__hash_string(__hash_seed, compiler), compiler_arguments);
+  for (size_t index = 0; index < srcc; index++) {
+
+    unsigned long long hash = __hash_string(flags_hash, srcv[index]), cached_hash = 0;
+    if (!force && __hash_depfile(&hash, depfiles[index]) && __cache_get(&cache, srcv[index], &cached_hash) && cached_hash == hash)
+      continue;
+    stale_sources[stale_count] = (char*)srcv[index];
+    stale_depfiles[stale_count++] = depfiles[index];
+  }
+
+  size_t failed = 0;
+  if (stale_count) {
+
+    const int jobs = __get_jobs(argc, argv);
+    const int threads_count = jobs < stale_count ? jobs : stale_count;
+    int* statuses = (int*)calloc(stale_count, sizeof *statuses);
+    printf("[I] Checking %zu of %d sources using %d jobs" _endl, stale_count, srcc, threads_count);
+    __run_jobs(threads_count, stale_count, stale_sources, stale_depfiles, statuses, NULL, &m8_syntax_check);
+
+    for (size_t index = 0; index < stale_count; index++) {
+
+      if (statuses[index]) {
+
+        failed++;
+        continue;
+      }
+      unsigned long long hash = __hash_string(flags_hash, stale_sources[index]);
+      if (__hash_depfile(&hash, stale_depfiles[index])) __cache_set(&cache, stale_sources[index], hash);
+    }
+    free(statuses);
+  }
+  if (__cache_save(&cache)) printf("[E] Unable to save check results to %s." _endl, cache.path);
+  __cache_free(&cache);
+  free(stale_depfiles);
+  free(stale_sources);
+  __free_object_files(srcc, depfiles);
+  printf("[I] Checked: %zu, up to date: %zu, failed: %zu." _endl, stale_count, srcc - stale_count, failed);
+  return failed ? 1 : 0;
+}
+
+
+static int m8_run(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
+
+  // Everything after `--` belongs to the program, so options are only parsed before it.
+  int arguments_index = 1;
+  while (arguments_index < argc && strcmp(argv[arguments_index], "--") != 0) arguments_index++;
+  const bool reload = __has_option(arguments_index, argv, "--reload");
+  int status = m8_build(arguments_index, argv, srcc, srcv);
+  if (status) return status;
+
+  printf("= = = [RUN] = = = = = = = = = = = =" _endl);
+  const char* const program = project_type == PROJECT_TYPE_EXECUTABLE ? __get_target_path() : run_command;
+  if (!program) {
+
+    printf("[E] Nothing to run: set `run_command` to launch a library project." _endl);
+    return 1;
+  }
+  size_t command_length = strlen(program) + 8;
+  for (int index = arguments_index + 1; index < argc; index++) command_length += strlen(argv[index]) + 1;
+  char* const command = (char*)calloc(command_length, 1);
+
+  // `exec` makes the shell replace itself, so the signal reaches the program.
+  strcat(strcpy(command, "exec "), program);
+  for (int index = arguments_index + 1; index < argc; index++)
+    strcat(strcat(command, " "), argv[index]);
+
+  if (!reload) {
+
+    printf("[I] Executing: %s" _endl, command + 5);
+    fflush(stdout);
+    status = system(command + 5);
+    free(command);
+    return __exit_code(status);
+  }
+
+  #ifdef _WIN32
+    printf("[E] `--reload` is not supported on this host." _endl);
+    free(command);
+    return 1;
+  #else
+    if (project_type != PROJECT_TYPE_SHARED_LIBRARY || !run_command) {
+
+      printf("[E] `--reload` requires a shared library project and `run_command`." _endl);
+      free(command);
+      return 1;
+    }
+    int signal_number = reload_signal;
+    for (int index = 1; index < arguments_index - 1; index++)
+      if (strcmp(argv[index], "--signal") == 0) signal_number = atoi(argv[index + 1]);
+
+    char target[256] = { 0 }, staged[264] = { 0 };
+    strcpy(target, __get_target_path());
+    sprintf(staged, "%s.m8new", target);
+    printf("[I] Executing: %s" _endl, command + 5);
+    fflush(stdout);
+    const pid_t child = fork();
+    if (child == 0) {
+
+      execl("/bin/sh", "sh", "-c", command, (char*)NULL);
+      _exit(127);
+    }
+    free(command);
+    if (child < 0) {
+
+      printf("[E] Unable to start %s." _endl, program);
+      return 1;
+    }
+
+    unsigned long long state = __hash_sources_state(srcc, srcv);
+    const struct timespec interval = { reload_interval / 1000, (reload_interval % 1000) * 1000000L };
+    for (;;) {
+
+      nanosleep(&interval, NULL);
+      if (waitpid(child, &status, WNOHANG) == child) {
+
+        printf("[I] Program exited with status %d." _endl, __exit_code(status));
+        return __exit_code(status);
+      }
+      const unsigned long long current_state = __hash_sources_state(srcc, srcv);
+      if (current_state == state) continue;
+      state = current_state;
+
+      // Build in a separate process, so compilation errors do not stop the running program.
+      printf("= = = [RELOAD] = = = = = = = = = = = =" _endl);
+      fflush(stdout);
+      const pid_t builder = fork();
+      if (builder == 0) {
+
+        char* const staged_output = (char*)calloc(strlen(output) + 7, 1);
+        sprintf(staged_output, "%s.m8new", output);
+        output = staged_output;
+        header_files_count = 0;
+
+        // `_exit` skips stdio buffers, which are not flushed per line when the output is not a terminal.
+        const int build_status = m8_build(arguments_index, argv, srcc, srcv);
+        fflush(stdout);
+        _exit(build_status);
+      }
+      int build_status = -1;
+      if (builder < 0 || waitpid(builder, &build_status, 0) != builder || build_status) {
+
+        printf("[E] Rebuild failed, keeping the running version." _endl);
+        remove(staged);
+        continue;
+      }
+
+      // The running program keeps the old inode mapped, `dlopen` picks up the new one.
+      if (rename(staged, target)) {
+
+        printf("[E] Unable to replace %s." _endl, target);
+        continue;
+      }
+      printf("[I] Reloaded %s, sending signal %d to %d." _endl, target, signal_number, (int)child);
+      kill(child, signal_number);
+    }
+  #endif
+}
+
+
+static int m8_asm(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
+
+  #ifdef _WIN32
+    printf("[E] `asm` is not supported on this host." _endl);
+    return 1;
+  #else
+    const char* source = NULL, * symbol = NULL, * compare = NULL;
+    for (int index = 2; index < argc; index++) {
+
+      if (strcmp(argv[index], "--compare") == 0 && index + 1 < argc) compare = argv[++index];
+      else if (!source) source = argv[index];
+      else if (!symbol) symbol = argv[index];
+    }
+    if (!source) {
+
+      printf("[E] Usage: %s asm <file> [symbol] [--compare \"<flags>\"]" _endl, *argv);
+      return 1;
+    }
+    bool known = false;
+    for (size_t index = 0; index < srcc && !known; index++) known = strcmp(srcv[index], source) == 0;
+    if (!known) printf("[W] %s is not a project source, using build flags anyway." _endl, source);
+
+    __setup_tree();
+    char** const objects_files = __get_build_files(1, &source, "asm.o");
+    char compare_object[512] = { 0 };
+    sprintf(compare_object, "%s.2", objects_files[0]);
+    size_t count = 0, compare_count = 0;
+    char** const lines = __disassemble(source, compiler_arguments, symbol, objects_files[0], &count);
+    char** const compare_lines = lines && compare ? __disassemble(source, compare, symbol, compare_object, &compare_count) : NULL;
+    int status = lines && (!compare || compare_lines) ? 0 : 1;
+    if (!status && !count) {
+
+      if (symbol) printf("[E] Symbol not found: %s." _endl, symbol);
+      else printf("[E] No functions found in %s." _endl, source);
+      status = 1;
+    } else if (!status && compare) {
+
+      // Side by side, left column is truncated to keep the right one aligned.
+      printf("%-60.60s | %s" _endl, compiler_arguments, compare);
+      for (size_t index = 0; index < count || index < compare_count; index++)
+        printf("%-60.60s | %s" _endl, index < count ? lines[index] : "", index < compare_count ? compare_lines[index] : "");
+    } else if (!status) {
+
+      for (size_t index = 0; index < count; index++) printf("%s" _endl, lines[index]);
+    }
+    if (lines) __free_object_files(count, lines);
+    if (compare_lines) __free_object_files(compare_count, compare_lines);
+    remove(objects_files[0]);
+    remove(compare_object);
+    __free_object_files(1, objects_files);
+    return status;
+  #endif
+}
+
+
+static int m8_coverage(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
+
+  #ifdef _WIN32
+    printf("[E] `coverage` is not supported on this host." _endl);
+    return 1;
+  #else
+    if (!tests_count) {
+
+      printf("[E] No tests declared, nothing to measure." _endl);
+      return 1;
+    }
+
+    // The instrumented variant lives in its own tree, so it never mixes with regular objects.
+    char* const original_build_dir = build_dir, * const original_dist_dir = dist_dir;
+    char* const original_compiler_arguments = compiler_arguments, * const original_linker_arguments = linker_arguments;
+    const size_t original_batch_size = batch_size;
+    char variant_build_dir[256] = { 0 }, variant_dist_dir[272] = { 0 }, profiles_dir[272] = { 0 }, directory[512] = { 0 };
+    mkdir(build_dir, 0755);
+    sprintf(variant_build_dir, "%s" __path_delim "coverage", build_dir);
+    sprintf(variant_dist_dir, "%s" __path_delim "dist", variant_build_dir);
+    sprintf(profiles_dir, "%s" __path_delim "profiles", variant_build_dir);
+    compiler_arguments = strcat(strcpy((char*)malloc(strlen(compiler_arguments) + 12), compiler_arguments), " --coverage");
+    linker_arguments = strcat(strcpy((char*)malloc(strlen(linker_arguments) + 12), linker_arguments), " --coverage");
+    build_dir = variant_build_dir;
+    dist_dir = variant_dist_dir;
+    // Notes name counters after their object, which a batch compiles elsewhere.
+    batch_size = 0;
+
+    // Counters are accumulated into existing files, so every run starts from scratch.
+    char** const data_files = __get_build_files(srcc, srcv, "gcda");
+    for (size_t index = 0; index < srcc; index++) remove(data_files[index]);
+    __remove_tree(profiles_dir);
+
+    int status = m8_build(argc, argv, srcc, srcv);
+    if (status == 0 && getcwd(directory, sizeof directory)) {
+
+      printf("= = = [COVERAGE] = = = = = = = = = = = =" _endl);
+      mkdir(profiles_dir, 0755);
+      const int jobs = __get_jobs(argc, argv), threads_count = jobs < tests_count ? jobs : tests_count;
+      char** const commands = (char**)calloc(tests_count, sizeof *commands);
+      char** const directories = (char**)calloc(tests_count, sizeof *directories);
+      int* const statuses = (int*)calloc(tests_count, sizeof *statuses);
+
+      // Every test writes its own profile tree: `GCOV_PREFIX` replaces the leading `GCOV_PREFIX_STRIP` components.
+      size_t strip = 0, profiles_count = 0;
+      for (const char* symbol = directory; *symbol; symbol++)
+        strip += symbol[0] == '/' && symbol[1] && symbol[1] != '/';
+      for (size_t test_id = 0; test_id < tests_count; test_id++) {
+
+        const m8_test_t* const test = tests + test_id;
+        directories[test_id] = (char*)calloc(strlen(profiles_dir) + 32, 1);
+        sprintf(directories[test_id], "%s" __path_delim "%zu", profiles_dir, test_id);
+        commands[test_id] = (char*)calloc(strlen(directory) + strlen(profiles_dir) + strlen(dist_dir) + strlen(test->executable)
+                                          + (test->arguments ? strlen(test->arguments) : 0) + 96, 1);
+        sprintf(commands[test_id], "GCOV_PREFIX=%s/%s GCOV_PREFIX_STRIP=%zu %s" __path_delim "%s %s",
+                directory, directories[test_id], strip, dist_dir, test->executable, test->arguments ? test->arguments : "");
+      }
+      printf("[I] Running %zu tests using %d jobs" _endl, tests_count, threads_count);
+      fflush(stdout);
+      __run_jobs(threads_count, tests_count, commands, commands, statuses, NULL, &__execute_commands);
+
+      for (size_t test_id = 0; test_id < tests_count; test_id++) {
+
+        // A crashed test leaves no profile, the rest of the run is still useful.
+        struct stat profile;
+        if (statuses[test_id]) printf("[E] Test failed: %s." _endl, commands[test_id]);
+        if (stat(directories[test_id], &profile) == 0) directories[profiles_count++] = directories[test_id];
+        else free(directories[test_id]);
+        status |= statuses[test_id];
+        free(commands[test_id]);
+      }
+      char* const profile = __merge_profiles(jobs, profiles_count, directories);
+      if (!profile || __report_coverage(jobs, srcc, srcv, data_files, profile)) {
+
+        printf("[E] Unable to produce coverage report." _endl);
+        status = 1;
+      }
+      free(profile);
+      free(statuses);
+      free(directories);
+      free(commands);
+    }
+    __free_object_files(srcc, data_files);
+    free(compiler_arguments);
+    free(linker_arguments);
+    compiler_arguments = original_compiler_arguments;
+    linker_arguments = original_linker_arguments;
+    build_dir = original_build_dir;
+    dist_dir = original_dist_dir;
+    batch_size = original_batch_size;
+    return status ? 1 : 0;
+  #endif
+}
+
+
+static int m8_bench(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
+
+  printf("= = = [BENCH] = = = = = = = = = = = =" _endl);
+  int repeat = 5, status = 0;
+  for (int index = 1; index < argc - 1; index++)
+    if (strcmp(argv[index], "--repeat") == 0) repeat = atoi(argv[index + 1]) > 0 ? atoi(argv[index + 1]) : 1;
+
+  // Every metric is stored as `<command>#<name>`, the wall time goes first.
+  const char* names[8] = { "wall-time-ns" };
+  size_t names_count = 1;
+  #ifdef __linux__
+    const m8_counter_t* counters = __hardware_counters;
+    size_t counters_count = countof(__hardware_counters);
+    const int probe = __open_counter(counters, 0, false);
+    if (probe < 0) {
+
+      printf("[W] Hardware counters are not available, using software ones." _endl);
+      counters = __software_counters;
+      counters_count = countof(__software_counters);
+    } else close(probe);
+    for (size_t counter_id = 0; counter_id < counters_count; counter_id++) names[names_count++] = counters[counter_id].name;
+  #endif
+
+  m8_cache_t cache = __cache_load("bench");
+  char* const command = (char*)malloc(8192);
+  char key[8448];
+  for (size_t benchmark_id = 0; benchmark_id < benchmarks_count; benchmark_id++) {
+
+    const m8_test_t* const benchmark = benchmarks + benchmark_id;
+    sprintf(command, "%s" __path_delim "%s%s%s", dist_dir, benchmark->executable,
+            benchmark->arguments ? " " : "", benchmark->arguments ? benchmark->arguments : "");
+    printf("[I] Benchmark %s (%zu/%zu), %d runs" _endl, command, benchmark_id + 1, benchmarks_count, repeat);
+    fflush(stdout);
+
+    double totals[8] = { 0 };
+    bool available[8] = { true, true, true, true, true, true, true, true };
+    int run_status = 0;
+    for (int run = 0; run < repeat && !run_status; run++) {
+
+      unsigned long long values[8] = { 0 };
+      double seconds = 0;
+      #ifdef __linux__
+        run_status = __run_measured(command, counters, counters_count, values, &seconds);
+      #else
+        const double started = __now();
+        run_status = system(command);
+        seconds = __now() - started;
+      #endif
+      totals[0] += seconds * 1e9;
+      for (size_t name_id = 1; name_id < names_count; name_id++) {
+
+        if (values[name_id - 1] == ~0ULL) available[name_id] = false;
+        else totals[name_id] += values[name_id - 1];
+      }
+    }
+    if (run_status) {
+
+      printf("[E] Benchmark returned non-zero value: %d." _endl, run_status);
+      status = 1;
+      continue;
+    }
+
+    for (size_t name_id = 0; name_id < names_count; name_id++) {
+
+      const unsigned long long value = (unsigned long long)(totals[name_id] / repeat + 0.5);
+      unsigned long long previous = 0;
+      char delta[32] = "(new)";
+      sprintf(key, "%s#%s", command, names[name_id]);
+      // A zero metric is valid history (e.g. no context switches), only the relative change is undefined.
+      if (__cache_get(&cache, key, &previous) && previous) sprintf(delta, "(%+.1f%%)", 100.0 * ((double)value - previous) / previous);
+      else if (__cache_get(&cache, key, &previous)) strcpy(delta, value ? "(n/a)" : "(+0.0%)");
+      if (!available[name_id]) {
+
+        printf("[I]   %-20s %18s" _endl, names[name_id], "n/a");
+        continue;
+      }
+      printf("[I]   %-20s %18llu %s" _endl, names[name_id], value, delta);
+      __cache_set(&cache, key, value);
+    }
+  }
+  free(command);
+  if (__cache_save(&cache)) printf("[E] Unable to save benchmark results to %s." _endl, cache.path);
+  __cache_free(&cache);
+  return status;
+}
+
+
+#ifndef _WIN32
+// Delta format: magic, old size and hash, new size and hash, then operations, all integers are little endian.
+#define __delta_magic "M8DELTA1"
+#define __delta_block 32
+enum { DELTA_COPY = 'C', DELTA_INSERT = 'I', DELTA_END = 'E' };
+
+// Old and new trees for `__generate_deltas` threads.
+static const char* __delta_roots[2] = { NULL, NULL };
+#endif
+
+
+static int m8_delta(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
+
+  #ifdef _WIN32
+    printf("[E] `delta` is not supported on this host." _endl);
+    return 1;
+  #else
+    const char* roots[2] = { NULL, NULL }, * output_dir = NULL;
+    for (int index = 2; index < argc; index++) {
+
+      if ((strcmp(argv[index], "-j") == 0 || strcmp(argv[index], "--jobs") == 0) && index + 1 < argc) index++;
+      else if (strcmp(argv[index], "-o") == 0 && index + 1 < argc) output_dir = argv[++index];
+      else if (!roots[0]) roots[0] = argv[index];
+      else if (!roots[1]) roots[1] = argv[index];
+    }
+    if (!roots[1]) {
+
+      printf("[E] Usage: %s delta <old-dist> <new-dist> [-o <dir>] [-j N]" _endl, *argv);
+      return 1;
+    }
+    printf("= = = [DELTA] = = = = = = = = = = = =" _endl);
+    char default_output_dir[256] = { 0 };
+    if (!output_dir) {
+
+      mkdir(build_dir, 0755);
+      sprintf(default_output_dir, "%s" __path_delim "delta", build_dir);
+      output_dir = default_output_dir;
+    }
+    // Only files written by a previous `delta` are cleared, the output may be any user directory.
+    mkdir(output_dir, 0755);
+    DIR* const previous = opendir(output_dir);
+    struct dirent* entry = NULL;
+    char old_path[1024], new_path[1024];
+    while (previous && (entry = readdir(previous))) {
+
+      const size_t length = strlen(entry->d_name);
+      if (strcmp(entry->d_name, "manifest") != 0 && (length < 8 || strcmp(entry->d_name + length - 8, ".m8delta") != 0)) continue;
+      sprintf(old_path, "%s" __path_delim "%s", output_dir, entry->d_name);
+      remove(old_path);
+    }
+    if (previous) closedir(previous);
+
+    m8_cache_t old_files = { 0 }, new_files = { 0 };
+    __list_files(roots[0], "", &old_files);
+    __list_files(roots[1], "", &new_files);
+
+    // Unchanged files are skipped, the rest gets a delta (new files are deltas against nothing).
+    char** const changed = (char**)calloc(new_files.count + 1, sizeof *changed);
+    char** const deltas = (char**)calloc(new_files.count + 1, sizeof *deltas);
+    size_t changed_count = 0, removed_count = 0;
+    for (size_t index = 0; index < new_files.count; index++) {
+
+      unsigned long long mode = 0, old_hash = __hash_seed, new_hash = __hash_seed;
+      sprintf(old_path, "%s" __path_delim "%s", roots[0], new_files.keys[index]);
+      sprintf(new_path, "%s" __path_delim "%s", roots[1], new_files.keys[index]);
+      if (__cache_get(&old_files, new_files.keys[index], &mode) && __hash_file(&old_hash, old_path)
+          && __hash_file(&new_hash, new_path) && old_hash == new_hash) continue;
+      changed[changed_count] = new_files.keys[index];
+      deltas[changed_count] = (char*)calloc(strlen(output_dir) + 32, 1);
+      sprintf(deltas[changed_count], "%s" __path_delim "%zu.m8delta", output_dir, changed_count);
+      changed_count++;
+    }
+
+    int status = 0;
+    if (changed_count) {
+
+      const int jobs = __get_jobs(argc, argv), threads_count = jobs < changed_count ? jobs : changed_count;
+      int* const statuses = (int*)calloc(changed_count, sizeof *statuses);
+      printf("[I] Generating %zu deltas using %d jobs" _endl, changed_count, threads_count);
+      fflush(stdout);
+      __delta_roots[0] = roots[0];
+      __delta_roots[1] = roots[1];
+      __run_jobs(threads_count, changed_count, changed, deltas, statuses, NULL, &__generate_deltas);
+      for (size_t index = 0; index < changed_count; index++) status |= statuses[index];
+      free(statuses);
+    }
+
+    // Manifest lines: `P <mode> <delta> <path>` for patched or added files and `D <path>` for removed ones.
+    char manifest_path[512] = { 0 };
+    sprintf(manifest_path, "%s" __path_delim "manifest", output_dir);
+    FILE* const manifest = fopen(manifest_path, "w");
+    if (!manifest) status = 1;
+    for (size_t index = 0; manifest && index < changed_count; index++) {
+
+      unsigned long long mode = 0;
+      __cache_get(&new_files, changed[index], &mode);
+      const char* const name = strrchr(deltas[index], __path_delim[0]) + 1;
+      fprintf(manifest, "P %llo %s %s\n", mode, name, changed[index]);
+    }
+    for (size_t index = 0; manifest && index < old_files.count; index++) {
+
+      unsigned long long mode = 0;
+      if (__cache_get(&new_files, old_files.keys[index], &mode)) continue;
+      fprintf(manifest, "D %s\n", old_files.keys[index]);
+      removed_count++;
+    }
+    if (manifest) fclose(manifest);
+
+    size_t delta_size = 0;
+    for (size_t index = 0; index < changed_count; index++) {
+
+      struct stat delta;
+      if (stat(deltas[index], &delta) == 0) delta_size += delta.st_size;
+      free(deltas[index]);
+    }
+    printf("[I] Changed: %zu, removed: %zu, unchanged: %zu, patches size: %zu bytes." _endl,
+           changed_count, removed_count, new_files.count - changed_count, delta_size);
+    if (status) printf("[E] Unable to generate deltas." _endl);
+    free(deltas);
+    free(changed);
+    __cache_free(&new_files);
+    __cache_free(&old_files);
+    return status ? 1 : 0;
+  #endif
+}
+
+
+static int m8_patch(const int argc, const char* const argv[], const int srcc, const char* const srcv[]) {
+
+  #ifdef _WIN32
+    printf("[E] `patch` is not supported on this host." _endl);
+    return 1;
+  #else
+    if (argc < 4) {
+
+      printf("[E] Usage: %s patch <dist> <delta-dir>" _endl, *argv);
+      return 1;
+    }
+    const char* const root = argv[2], * const delta_dir = argv[3];
+    printf("= = = [PATCH] = = = = = = = = = = = =" _endl);
+    char path[1024], line[4096];
+    sprintf(path, "%s" __path_delim "manifest", delta_dir);
+    FILE* const manifest = fopen(path, "r");
+    if (!manifest) {
+
+      printf("[E] Unable to read %s." _endl, path);
+      return 1;
+    }
+
+    // Every file is staged and verified first, so a bad patch leaves the tree untouched.
+    m8_cache_t staged = { 0 }, removed = { 0 };
+    int status = 0;
+    while (!status && fgets(line, sizeof line, manifest)) {
+
+      unsigned int mode = 0;
+      int offset = 0;
+      unsigned long long duplicate = 0;
+      char delta_name[64] = { 0 };
+      line[strcspn(line, "\r\n")] = '\0';
+      if (line[0] == 'D' && line[1] == ' ' && __is_contained_path(line + 2)) {
+
+        __cache_set(&removed, line + 2, 0);
+        continue;
+      }
+      if (sscanf(line, "P %o %63s %n", &mode, delta_name, &offset) != 2
+          || !__is_contained_path(delta_name) || !__is_contained_path(line + offset) || __cache_get(&staged, line + offset, &duplicate)) {
+
+        printf("[E] Malformed manifest line: %s" _endl, line);
+        status = 1;
+        break;
+      }
+      const char* const relative = line + offset;
+      size_t old_size = 0, new_size = 0;
+      sprintf(path, "%s" __path_delim "%s", root, relative);
+      unsigned char* const old = __read_file(path, &old_size);
+      sprintf(path, "%s" __path_delim "%s", delta_dir, delta_name);
+      FILE* const delta = fopen(path, "rb");
+      unsigned char* const contents = delta ? __apply_delta(delta, old, old_size, &new_size) : NULL;
+      if (delta) fclose(delta);
+      free(old);
+
+      // Staged files are kept flat in the root, so a failed patch does not even leave new directories.
+      sprintf(path, "%s" __path_delim ".m8patch.%zu", root, staged.count);
+      FILE* const file = contents ? fopen(path, "wb") : NULL;
+      if (!file || fwrite(contents, 1, new_size, file) != new_size) status = 1;
+      if (file) fclose(file);
+      if (file) chmod(path, mode);
+      free(contents);
+      __cache_set(&staged, relative, 0);
+      printf("[I] Verify %s... %s" _endl, relative, status ? "[FAILED]" : "[OK]");
+    }
+    fclose(manifest);
+
+    char target[1024];
+    size_t replaced = 0;
+    for (size_t index = 0; index < staged.count; index++) {
+
+      sprintf(path, "%s" __path_delim ".m8patch.%zu", root, index);
+      sprintf(target, "%s" __path_delim "%s", root, staged.keys[index]);
+      if (status) {
+
+        remove(path);
+        continue;
+      }
+      __make_parents(target);
+      if (rename(path, target)) {
+
+        printf("[E] Unable to replace %s." _endl, target);
+        remove(path);
+        status = 1;
+      } else replaced++;
+    }
+    for (size_t index = 0; !status && index < removed.count; index++) {
+
+      sprintf(target, "%s" __path_delim "%s", root, removed.keys[index]);
+      printf("[I] Remove %s... %s" _endl, target, remove(target) == 0 ? "[OK]" : "[FAILED]");
+    }
+    if (status && replaced) printf("[E] Patch failed after replacing %zu of %zu files, the tree is partially updated." _endl, replaced, staged.count);
+    else if (status) printf("[E] Patch failed, the tree was not changed." _endl);
+    else printf("[I] Patched %zu files, removed %zu." _endl, staged.count, removed.count);
+    __cache_free(&removed);
+    __cache_free(&staged);
+    return status;
+  #endif
+}
+
+
+static thread_return_t m8_compile(const thread_arg_t data) {
+
+  const m8_compilation_list_t* const list = (const m8_compilation_list_t*)data;
+  // TODO: Compute the command size.
+  char* command = (char*)malloc(8192);
+  size_t unbatched_end = 0;
+  #ifndef _WIN32
+    // Batching needs history to size batches, the live view tracks one source per slot.
+    bool batching = batch_size > 1 && list->timev;
+    #ifdef __linux__
+      batching = batching && !__monitor.slots;
+    #endif
+
+    // Only objects and dependency files are moved out of a batch, other outputs would stay behind
+    // and coverage objects would point their counters at the batch directory.
+    static const char* const side_outputs[] = { "--coverage", "-ftest-coverage", "-fprofile-arcs", "-gsplit-dwarf", "-save-temps" };
+    for (size_t option = 0; option < countof(side_outputs) && batching; option++)
+      batching = strstr(compiler_arguments, side_outputs[option]) == NULL;
+    char* const arguments = batching ? __absolute_arguments(compiler_arguments) : NULL;
+  #endif
+  for (size_t index = 0; index < list->count; index++) {
+
+    #ifndef _WIN32
+      if (batching && index >= unbatched_end) {
+
+        // A failed batch is compiled again source by source, so errors are attributed to the right file.
+        const size_t end = __get_batch_end(list, index);
+        if (end - index > 1 && __compile_batch(list, index, end, arguments)) {
+
+          index = end - 1;
+          continue;
+        } else unbatched_end = end;
+      }
+    #endif
+
+    // TODO: Add formatting options for Windows.
+    const char* format = "%s %s -o %s %s%s%s";
+    sprintf(command, format, compiler, compiler_arguments, list->objv[index], source_dir, __path_delim, list->srcv[index]);
+    const double started = __now();
+    int status = 0;
+    #ifdef __linux__
+      if (__monitor.slots) status = __execute_job(command, list->objv[index], list->srcv[index], list->slot);
+      else
+    #endif
+    {
+      printf("[I] Executing (%ld/%ld): %s" _endl, index + 1, list->count, command);
+      status = system(command);
+    }
+    if (list->timev) list->timev[index] = (unsigned long long)((__now() - started) * 1000) + 1;
+    if (status && list->statusv) {
+
+      list->statusv[index] = status;
+      break;
+    } else if (status) {
+
+      printf("[E] Compiler returned non-zero value: %d. Aborting." _endl, status);
+      free(command);
+      // Wait statuses are truncated to 8 bits by `exit`, so report a plain failure.
+      exit(EXIT_FAILURE);
+    }
+  }
+  #ifndef _WIN32
+    free(arguments);
+  #endif
+  free(command);
+  return 0;
+}
+
+
+static thread_return_t m8_syntax_check(const thread_arg_t data) {
+
+  const m8_compilation_list_t* const list = (const m8_compilation_list_t*)data;
+  char* command = (char*)malloc(8192);
+  for (size_t index = 0; index < list->count; index++) {
+
+    // TODO: Add formatting options for Windows.
+    const char* format = "%s %s -fsyntax-only -MMD -MF %s %s%s%s";
+    sprintf(command, format, compiler, compiler_arguments, list->objv[index], source_dir, __path_delim, list->srcv[index]);
+    printf("[I] Executing (%zu/%zu): %s" _endl, index + 1, list->count, command);
+    const int status = system(command);
+    if (status) printf("[E] Check failed for %s: %d." _endl, list->srcv[index], status);
+    list->statusv[index] = status;
+  }
+  free(command);
+  return 0;
+}
+
+
+#ifndef _WIN32
+static size_t __get_batch_end(const m8_compilation_list_t* const list, const size_t begin) {
+
+  unsigned long long cost = 0;
+  size_t end = begin;
+  while (end < list->count && end - begin < batch_size) {
+
+    // Unknown sources (no history yet) cost nothing, so the first build batches everything.
+    const unsigned long long source_cost = list->timev[end];
+    if (source_cost >= batch_cost) return end > begin ? end : begin + 1;
+    if (cost + source_cost > batch_cost) break;
+
+    const char* const name = strrchr(list->srcv[end], __path_delim[0]) ? strrchr(list->srcv[end], __path_delim[0]) + 1 : list->srcv[end];
+    const size_t name_length = strrchr(name, '.') ? (size_t)(strrchr(name, '.') - name) : strlen(name);
+    bool unique = true;
+    for (size_t other = begin; other < end && unique; other++) {
+
+      const char* const other_name = strrchr(list->srcv[other], __path_delim[0]) ? strrchr(list->srcv[other], __path_delim[0]) + 1 : list->srcv[other];
+      const size_t other_length = strrchr(other_name, '.') ? (size_t)(strrchr(other_name, '.') - other_name) : strlen(other_name);
+      unique = name_length != other_length || strncmp(name, other_name, name_length) != 0;
+    }
+    if (!unique) break;
+    cost += source_cost;
+    end++;
+  }
+  return end;
+}
+
+
+static bool __compile_batch(const m8_compilation_list_t* const list, const size_t begin, const size_t end, const char* const arguments) {
+
+  char directory[512] = { 0 }, batch_dir[512] = { 0 }, log[600] = { 0 }, path[1024] = { 0 }, target[1024] = { 0 };
+  if (!getcwd(directory, sizeof directory)) return false;
+  sprintf(batch_dir, "%s" __path_delim "batch.%zu", build_dir, list->slot);
+  sprintf(log, "%s" __path_delim "batch.log", batch_dir);
+  mkdir(batch_dir, 0755);
+
+  // Paths are mapped back to the unbatched spelling (`src/x.c`, compilation directory is the project root),
+  // so `__FILE__` and debug info do not depend on whether a source was batched. The last map is tried first.
+  size_t length = strlen(batch_dir) + strlen(compiler) + strlen(arguments) + 4 * strlen(directory) + 128;
+  for (size_t index = begin; index < end; index++) length += strlen(directory) + strlen(source_dir) + strlen(list->srcv[index]) + 3;
+  char* const command = (char*)malloc(length);
+  sprintf(command, "cd %s && %s %s -ffile-prefix-map=%s/= -ffile-prefix-map=%s/%s=%s", batch_dir, compiler, arguments,
+          directory, directory, batch_dir, directory);
+  for (size_t index = begin; index < end; index++)
+    sprintf(command + strlen(command), " %s" __path_delim "%s" __path_delim "%s", directory, source_dir, list->srcv[index]);
+  printf("[I] Executing batch (%zu-%zu/%zu): %s" _endl, begin + 1, end, list->count, command);
+  strcat(command, " > batch.log 2>&1");
+
+  // Objects are named after sources: `dir/name.c` -> `name.o`.
+  char** const stems = (char**)calloc(end - begin, sizeof *stems);
+  for (size_t index = begin; index < end; index++) {
+
+    const char* const name = strrchr(list->srcv[index], __path_delim[0]) ? strrchr(list->srcv[index], __path_delim[0]) + 1 : list->srcv[index];
+    stems[index - begin] = (char*)calloc(strlen(batch_dir) + strlen(name) + 4, 1);
+    sprintf(stems[index - begin], "%s" __path_delim "%s", batch_dir, name);
+    if (strrchr(name, '.')) *strrchr(stems[index - begin], '.') = '\0';
+    sprintf(path, "%s.o", stems[index - begin]);
+    remove(path);
+  }
+
+  const double started = __now();
+  const int status = system(command);
+  const unsigned long long duration = (unsigned long long)((__now() - started) * 1000 / (end - begin)) + 1;
+  bool complete = status == 0;
+  for (size_t index = begin; index < end && complete; index++) {
+
+    sprintf(path, "%s.o", stems[index - begin]);
+    FILE* const object = fopen(path, "rb");
+    if (object) fclose(object);
+    complete = object != NULL;
+  }
+  for (size_t index = begin; index < end && complete; index++) {
+
+    sprintf(path, "%s.o", stems[index - begin]);
+    complete = rename(path, list->objv[index]) == 0;
+    list->timev[index] = duration;
+
+    // Dependency files name the object in the batch directory: `name.o: ...` -> `build/x.c.o: ...`.
+    sprintf(path, "%s.d", stems[index - begin]);
+    FILE* const depfile = fopen(path, "r");
+    if (!depfile) continue;
+    strcpy(target, list->objv[index]);
+    if (strrchr(target, '.') > strrchr(target, __path_delim[0])) strcpy(strrchr(target, '.'), ".d");
+    FILE* const moved = fopen(target, "w");
+    if (moved) {
+
+      int symbol = 0;
+      bool inside = false;
+      fputs(list->objv[index], moved);
+      while ((symbol = fgetc(depfile)) != EOF) {
+
+        inside = inside || symbol == ':';
+        if (inside) fputc(symbol, moved);
+      }
+      fclose(moved);
+    }
+    fclose(depfile);
+    remove(path);
+  }
+  if (complete) __print_file(log);
+  for (size_t index = begin; index < end; index++) free(stems[index - begin]);
+  free(stems);
+  free(command);
+  return complete;
+}
+
+
+static char* __absolute_arguments(const char* const arguments) {
+
+  static const char* const options[] = { "-isystem", "-iquote", "-idirafter", "-include", "-imacros", "-I" };
+  char directory[512] = { 0 };
+  if (!getcwd(directory, sizeof directory)) *directory = '\0';
+  const size_t directory_length = strlen(directory) + 1;
+  char* const result = (char*)calloc(strlen(arguments) + directory_length * (strlen(arguments) / 2 + 1) + 1, 1);
+  bool path_expected = false;
+  for (const char* token = arguments; *token;) {
+
+    const size_t token_length = strcspn(token, " \t");
+    if (token_length == 0) {
+
+      strncat(result, token++, 1);
+      continue;
+    }
+
+    // Both `-Idir` and `-I dir` forms are handled.
+    size_t path_offset = path_expected ? 0 : token_length;
+    const bool path_token = path_expected;
+    path_expected = false;
+    for (size_t option_id = 0; option_id < countof(options) && !path_token; option_id++) {
+
+      const size_t option_length = strlen(options[option_id]);
+      if (strncmp(token, options[option_id], option_length) != 0) continue;
+      path_expected = option_length == token_length;
+      path_offset = option_length;
+      break;
+    }
+    strncat(result, token, path_offset);
+    if (path_offset < token_length && token[path_offset] != '/' && *directory) {
+
+      strcat(result, directory);
+      strcat(result, "/");
+    }
+    strncat(result, token + path_offset, token_length - path_offset);
+    token += token_length;
+  }
+  return result;
+}
+
+
+static void __list_files(const char* const root, const char* const relative, m8_cache_t* const files) {
+
+  char path[2048], child[1024];
+  sprintf(path, "%s%s%s", root, *relative ? __path_delim : "", relative);
+  DIR* const directory = opendir(path);
+  struct dirent* entry = NULL;
+  while (directory && (entry = readdir(directory))) {
+
+    struct stat status;
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+    sprintf(child, "%s%s%s", relative, *relative ? __path_delim : "", entry->d_name);
+    sprintf(path, "%s" __path_delim "%s", root, child);
+    if (stat(path, &status) != 0) continue;
+    if (S_ISDIR(status.st_mode)) __list_files(root, child, files);
+    else if (S_ISREG(status.st_mode)) __cache_set(files, child, status.st_mode & 07777);
+  }
+  if (directory) closedir(directory);
+  return;
+}
+
+
+static void __make_parents(const char* const path) {
+
+  char buffer[1024] = { 0 };
+  if (snprintf(buffer, sizeof buffer, "%s", path) >= (int)sizeof buffer) return;
+  for (char* symbol = buffer + 1; *symbol; symbol++) {
+
+    if (*symbol != __path_delim[0]) continue;
+    *symbol = '\0';
+    mkdir(buffer, 0755);
+    *symbol = __path_delim[0];
+  }
+  return;
+}
+
+
+static bool __is_contained_path(const char* const path) {
+
+  if (!*path || *path == '/' || *path == '\\') return false;
+  for (const char* component = path; component; component = strpbrk(component, "/\\")) {
+
+    if (*component == '/' || *component == '\\') component++;
+    if (component[0] == '.' && component[1] == '.' && (!component[2] || component[2] == '/' || component[2] == '\\')) return false;
+  }
+  return true;
+}
+
+
+static unsigned char* __read_file(const char* const path, size_t* const size) {
+
+  *size = 0;
+  FILE* const file = fopen(path, "rb");
+  if (!file) return NULL;
+  fseek(file, 0, SEEK_END);
+  const long length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  unsigned char* const contents = (unsigned char*)malloc(length > 0 ? length : 1);
+  *size = length > 0 ? fread(contents, 1, length, file) : 0;
+  fclose(file);
+  return contents;
+}
+
+
+static void __write_number(FILE* const file, unsigned long long value) {
+
+  for (size_t byte = 0; byte < 8; byte++, value >>= 8) fputc((int)(value & 0xFF), file);
+  return;
+}
+
+
+static bool __read_number(FILE* const file, unsigned long long* const value) {
+
+  *value = 0;
+  for (size_t byte = 0; byte < 8; byte++) {
+
+    const int symbol = fgetc(file);
+    if (symbol == EOF) return false;
+    *value |= (unsigned long long)symbol << (8 * byte);
+  }
+  return true;
+}
+
+
+static int __write_delta(
+  FILE* const file,
+  const unsigned char* const old,
+  const size_t old_size,
+  const unsigned char* const new,
+  const size_t new_size
+) {
+
+  // Polynomial rolling hash over `__delta_block` bytes, `power` removes the outgoing byte.
+  const unsigned int base = 16777619u;
+  unsigned int power = 1;
+  for (size_t index = 1; index < __delta_block; index++) power *= base;
+
+  fwrite(__delta_magic, 1, 8, file);
+  __write_number(file, old_size);
+  __write_number(file, __hash_bytes(__hash_seed, old, old_size));
+  __write_number(file, new_size);
+  __write_number(file, __hash_bytes(__hash_seed, new, new_size));
+
+  // Index aligned blocks of the old contents, the first block wins on collisions.
+  size_t table_size = 1, shift = 32;
+  while (table_size < 2 * (old_size / __delta_block) + 1) table_size <<= 1, shift--;
+  size_t* const table = (size_t*)malloc(table_size * sizeof *table);
+  for (size_t index = 0; index < table_size; index++) table[index] = (size_t)-1;
+  for (size_t offset = 0; offset + __delta_block <= old_size; offset += __delta_block) {
+
+    unsigned int hash = 0;
+    for (size_t index = 0; index < __delta_block; index++) hash = hash * base + old[offset + index];
+    const size_t slot = shift < 32 ? (size_t)((hash * 2654435761u) >> shift) : 0;
+    if (table[slot] == (size_t)-1) table[slot] = offset;
+  }
+
+  size_t position = 0, literal = 0;
+  unsigned int hash = 0;
+  for (size_t index = 0; index < __delta_block && index < new_size; index++) hash = hash * base + new[index];
+  while (old_size >= __delta_block && position + __delta_block <= new_size) {
+
+    const size_t slot = shift < 32 ? (size_t)((hash * 2654435761u) >> shift) : 0;
+    const size_t candidate = table[slot];
+    if (candidate != (size_t)-1 && memcmp(old + candidate, new + position, __delta_block) == 0) {
+
+      // Extend the match in both directions, backwards only into pending literals.
+      size_t back = 0, length = __delta_block;
+      while (back < position - literal && back < candidate && old[candidate - back - 1] == new[position - back - 1]) back++;
+      const size_t new_offset = position - back, old_offset = candidate - back;
+      length += back;
+      while (new_offset + length < new_size && old_offset + length < old_size && new[new_offset + length] == old[old_offset + length])
+        length++;
+      if (new_offset > literal) {
+
+        fputc(DELTA_INSERT, file);
+        __write_number(file, new_offset - literal);
+        fwrite(new + literal, 1, new_offset - literal, file);
+      }
+      fputc(DELTA_COPY, file);
+      __write_number(file, old_offset);
+      __write_number(file, length);
+      position = literal = new_offset + length;
+      hash = 0;
+      for (size_t index = 0; index < __delta_block && position + index < new_size; index++) hash = hash * base + new[position + index];
+      continue;
+    }
+    if (position + __delta_block < new_size) hash = (hash - new[position] * power) * base + new[position + __delta_block];
+    position++;
+  }
+  if (new_size > literal) {
+
+    fputc(DELTA_INSERT, file);
+    __write_number(file, new_size - literal);
+    fwrite(new + literal, 1, new_size - literal, file);
+  }
+  fputc(DELTA_END, file);
+  free(table);
+  return ferror(file) ? -1 : 0;
+}
+
+
+static unsigned char* __apply_delta(FILE* const file, const unsigned char* const old, const size_t old_size, size_t* const new_size) {
+
+  char magic[8] = { 0 };
+  unsigned long long expected_old_size = 0, old_hash = 0, size = 0, new_hash = 0;
+  if (fread(magic, 1, 8, file) != 8 || memcmp(magic, __delta_magic, 8) != 0) return NULL;
+  if (!__read_number(file, &expected_old_size) || !__read_number(file, &old_hash)) return NULL;
+  if (!__read_number(file, &size) || !__read_number(file, &new_hash)) return NULL;
+
+  // Added files are deltas against empty contents.
+  if (expected_old_size != (old ? old_size : 0) || old_hash != __hash_bytes(__hash_seed, old, old ? old_size : 0)) return NULL;
+
+  // New contents are built from old bytes and inserted ones, so anything larger is a malformed delta.
+  const long header_end = ftell(file);
+  fseek(file, 0, SEEK_END);
+  const long delta_size = ftell(file);
+  fseek(file, header_end, SEEK_SET);
+  if (header_end < 0 || delta_size < header_end || size > (unsigned long long)old_size + (unsigned long long)(delta_size - header_end)
+      || size > (size_t)-1) return NULL;
+  unsigned char* const contents = (unsigned char*)malloc(size ? size : 1);
+  if (!contents) return NULL;
+  size_t position = 0;
+  bool valid = true;
+  for (int operation = fgetc(file); valid && operation != DELTA_END; operation = fgetc(file)) {
+
+    unsigned long long offset = 0, length = 0;
+    if (operation == DELTA_COPY && __read_number(file, &offset) && __read_number(file, &length)
+        && length <= old_size && offset <= old_size - length && length <= size - position) {
+
+      memcpy(contents + position, old + offset, length);
+      position += length;
+    } else if (operation == DELTA_INSERT && __read_number(file, &length) && length <= size - position
+               && fread(contents + position, 1, length, file) == length) {
+
+      position += length;
+    } else valid = false;
+  }
+  if (!valid || position != size || new_hash != __hash_bytes(__hash_seed, contents, size)) {
+
+    free(contents);
+    return NULL;
+  }
+  *new_size = size;
+  return contents;
+}
+
+
+static thread_return_t __generate_deltas(const thread_arg_t data) {
+
+  const m8_compilation_list_t* const list = (const m8_compilation_list_t*)data;
+  char path[1024];
+  for (size_t index = 0; index < list->count; index++) {
+
+    size_t old_size = 0, new_size = 0;
+    sprintf(path, "%s" __path_delim "%s", __delta_roots[0], list->srcv[index]);
+    unsigned char* const old = __read_file(path, &old_size);
+    sprintf(path, "%s" __path_delim "%s", __delta_roots[1], list->srcv[index]);
+    unsigned char* const new = __read_file(path, &new_size);
+    FILE* const file = new ? fopen(list->objv[index], "wb") : NULL;
+    list->statusv[index] = file ? __write_delta(file, old, old_size, new, new_size) : -1;
+    if (file && fclose(file)) list->statusv[index] = -1;
+    printf("[I] Delta %s: %zu -> %zu bytes... %s" _endl, list->srcv[index], old_size, new_size,
+           list->statusv[index] ? "[FAILED]" : "[OK]");
+    free(old);
+    free(new);
+  }
+  return 0;
+}
+#endif
+
+
+static thread_return_t __execute_commands(const thread_arg_t data) {
+
+  const m8_compilation_list_t* const list = (const m8_compilation_list_t*)data;
+  for (size_t index = 0; index < list->count; index++)
+    list->statusv[index] = system(list->srcv[index]);
+  return 0;
+}
+
+
+static int m8_link(const int objc, const char* const objv[]) {
+
+  // TODO: Compute the command size.
+  char* command = (char*)malloc(512 + objc * 256);
+  // TODO: Support Windows.
+  if (project_type == PROJECT_TYPE_STATIC_LIBRARY) {
+    sprintf(command, "%s r -o %s", ar, __get_target_path());
+  } else sprintf(command, "%s -o %s", linker, __get_target_path());
+  for (size_t index = 0; index < objc; index++) {
+
+    strcat(command, " ");
+    strcat(command, objv[index]);
+  }
+  strcat(command, " ");
+  strcat(command, linker_arguments);
+  printf("[I] Executing: %s" _endl, command);
+  const int status = system(command);
+  free(command);
+  return status;
+}
+
+
+static inline int m8_command(const m8_command_t* const command) {
+
+  __setup_tree();
+  char* const path = (char*)calloc(strlen(build_dir) + strlen(command->name) + 10, 1);
+  char* const trace = (char*)calloc(strlen(build_dir) + strlen(command->name) + 10, 1);
+  sprintf(path, "%s" __path_delim "%s.deps", build_dir, command->name);
+  sprintf(trace, "%s" __path_delim "%s.trace", build_dir, command->name);
+
+  // Discovered inputs are stored one per line.
+  m8_cache_t dependencies = { 0 };
+  FILE* file = fopen(path, "r");
+  if (file) {
+
+    char line[4096];
+    while (fgets(line, sizeof line, file)) {
+
+      line[strcspn(line, "\r\n")] = '\0';
+      if (*line) __cache_set(&dependencies, line, 1);
+    }
+    fclose(file);
+  }
+
+  unsigned long long hash = __hash_string(__hash_seed, command->command), cached_hash = 0;
+  for (size_t index = 0; index < command->inputs_count; index++)
+    __hash_file(&hash, command->inputs[index]);
+  for (size_t index = 0; index < dependencies.count; index++)
+    __hash_file(&hash, dependencies.keys[index]);
+  bool outputs_exist = true;
+  for (size_t index = 0; index < command->outputs_count; index++) {
+
+    FILE* const output_file = fopen(command->outputs[index], "rb");
+    if (output_file) fclose(output_file);
+    else outputs_exist = false;
+  }
 
-    strcat(command, " ");
-    strcat(command, objv[index]);
+  m8_cache_t cache = __cache_load("commands");
+  int status = 0;
+  if (outputs_exist && __cache_get(&cache, command->name, &cached_hash) && cached_hash == hash)
+    printf("[I] Job `%s` is up to date." _endl, command->name);
+  else {
+
+    printf("[I] Executing `%s`: %s" _endl, command->name, command->command);
+    fflush(stdout);
+    if (trace_commands) {
+
+      remove(trace);
+      status = __execute_traced(command->command, trace);
+      m8_cache_t files = { 0 };
+      if (__read_trace(trace, &files)) {
+
+        __cache_free(&dependencies);
+        for (size_t index = 0; index < files.count; index++) {
+
+          const char* const file_path = files.keys[index];
+          bool declared = false;
+          if (files.values[index] == 1) {
+
+            __cache_set(&dependencies, file_path, 1);
+            for (size_t input_id = 0; input_id < command->inputs_count && !declared; input_id++)
+              declared = strcmp(command->inputs[input_id], file_path) == 0;
+            if (!declared) printf("[W] Job `%s` reads undeclared input: %s" _endl, command->name, file_path);
+          } else {
+
+            for (size_t output_id = 0; output_id < command->outputs_count && !declared; output_id++)
+              declared = strcmp(command->outputs[output_id], file_path) == 0;
+            if (!declared) printf("[W] Job `%s` writes undeclared output: %s" _endl, command->name, file_path);
+          }
+        }
+        if ((file = fopen(path, "w"))) {
+
+          for (size_t index = 0; index < dependencies.count; index++)
+            fprintf(file, "%s\n", dependencies.keys[index]);
+          fclose(file);
+        }
+      }
+      __cache_free(&files);
+    } else status = system(command->command);
+
+    if (status == 0) {
+
+      // Hash again, as discovered inputs might have changed.
+      hash = __hash_string(__hash_seed, command->command);
+      for (size_t index = 0; index < command->inputs_count; index++)
+        __hash_file(&hash, command->inputs[index]);
+      for (size_t index = 0; index < dependencies.count; index++)
+        __hash_file(&hash, dependencies.keys[index]);
+      __cache_set(&cache, command->name, hash);
+      if (__cache_save(&cache)) printf("[E] Unable to save job state to %s." _endl, cache.path);
+    } else printf("[E] Job `%s` returned non-zero value: %d." _endl, command->name, status);
   }
-  strcat(command, " ");
-  strcat(command, linker_arguments);
-  printf("[I] Executing: %s" _endl, command);
-  const int status = system(command);
-  free(command);
+  __cache_free(&cache);
+  __cache_free(&dependencies);
+  free(trace);
+  free(path);
   return status;
 }
 
 
 static char** __get_object_files(const int srcc, const char* const srcv[]) {
 
-  const size_t object_prefix_length = strlen(build_dir) + strlen(objects) + 2;
+  return __get_build_files(srcc, srcv, objects);
+}
+
+
+static char** __get_build_files(const int srcc, const char* const srcv[], const char* const extension) {
+
+  const size_t object_prefix_length = strlen(build_dir) + strlen(extension) + 3;
   char** object_files = (char**)calloc(srcc, sizeof *srcv);
   for (size_t index = 0; index < srcc; index++) {
 
     const size_t source_length = strlen(srcv[index]), object_length = source_length + object_prefix_length;
     object_files[index] = (char*)calloc(object_length, 1);
-    sprintf(object_files[index], "%s%s%s.%s", build_dir, __path_delim, srcv[index], objects);
-    for (char* symbol = object_files[index] + object_prefix_length + 1; symbol < object_files[index] + object_length; symbol++)
+    sprintf(object_files[index], "%s%s%s.%s", build_dir, __path_delim, srcv[index], extension);
+    for (char* symbol = object_files[index] + strlen(build_dir) + 1; symbol < object_files[index] + object_length; symbol++)
       if (*symbol == __path_delim[0]) *symbol = '.';
   }
   return object_files;
@@ -576,6 +2701,76 @@ static inline void __free_object_files(const int count, char** const files) {
 }
 
 
+static void __run_jobs(
+  const int jobs,
+  const size_t count,
+  char** const srcv,
+  char** const objv,
+  int* const statusv,
+  unsigned long long* const timev,
+  thread_return_t(*function)(thread_arg_t)
+) {
+
+  // The first `count % jobs` threads take one extra source each.
+  const size_t job_sources = count / jobs, remaining_sources = count % jobs;
+  m8_compilation_list_t* lists = (m8_compilation_list_t*)calloc(jobs, sizeof(m8_compilation_list_t));
+  thread_t* threads = (thread_t*)calloc(jobs, sizeof (thread_t));
+  size_t offset = 0;
+  for (size_t thread_id = 0; thread_id < jobs; thread_id++) {
+
+    lists[thread_id].count = job_sources + (thread_id < remaining_sources);
+    lists[thread_id].srcv = srcv + offset;
+    lists[thread_id].objv = objv + offset;
+    lists[thread_id].statusv = statusv ? statusv + offset : NULL;
+    lists[thread_id].timev = timev ? timev + offset : NULL;
+    lists[thread_id].slot = thread_id;
+    offset += lists[thread_id].count;
+    threads[thread_id] = __create_thread(function, &lists[thread_id]);
+  }
+  __wait_jobs(jobs, threads);
+  free(threads);
+  free(lists);
+  return;
+}
+
+
+static bool __hash_depfile(unsigned long long* const hash, const char* const depfile) {
+
+  FILE* const file = fopen(depfile, "r");
+  if (!file) return false;
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  char* const contents = (char*)calloc(size + 1, 1);
+  const size_t read = fread(contents, 1, size, file);
+  fclose(file);
+  contents[read] = '\0';
+
+  // Format: `target: dependency dependency \<newline> dependency ...`.
+  bool complete = true;
+  char* dependency = strchr(contents, ':');
+  dependency = dependency ? dependency + 1 : contents + read;
+  while (*dependency) {
+
+    while (*dependency == ' ' || *dependency == '\t' || *dependency == '\\' || *dependency == '\r' || *dependency == '\n')
+      dependency++;
+    char* end = dependency;
+    while (*end && *end != ' ' && *end != '\t' && *end != '\r' && *end != '\n' && !(end[0] == '\\' && (end[1] == '\n' || end[1] == '\r')))
+      end++;
+    if (end == dependency) break;
+    const char separator = *end;
+    *end = '\0';
+    *hash = __hash_string(*hash, dependency);
+    complete = __hash_file(hash, dependency) && complete;
+    if (!separator) break;
+    *end = separator;
+    dependency = end;
+  }
+  free(contents);
+  return complete;
+}
+
+
 static void __setup_tree(void) {
 
   mkdir(build_dir, 0755);
@@ -604,6 +2799,16 @@ static int __get_jobs(const int argc, const char* const argv[]) {
 }
 
 
+static int __exit_code(const int status) {
+
+  #ifdef _WIN32
+    return status;
+  #else
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+  #endif
+}
+
+
 thread_t __create_thread(thread_return_t(*function)(thread_arg_t), thread_arg_t argument) {
 
   #ifdef _WIN32
@@ -649,4 +2854,869 @@ static inline int __copy(const char* const source, const char* const destanation
   return system(buffer);
 }
 
+
+static inline int __remove_tree(const char* const path) {
+
+  char buffer[512] = { 0 };
+  #ifdef _WIN32
+    sprintf(buffer, "rmdir /s /q %s 2>nul", path);
+  #else
+    sprintf(buffer, "rm -rf %s", path);
+  #endif
+  return system(buffer);
+}
+
+
+#ifndef _WIN32
+static char* __merge_profiles(const int jobs, size_t count, char** const directories) {
+
+  char** const commands = (char**)calloc(count / 2 + 1, sizeof *commands);
+  int* const statuses = (int*)calloc(count / 2 + 1, sizeof *statuses);
+  int status = 0;
+  for (size_t round = 0; count > 1; round++) {
+
+    const size_t pairs = count / 2;
+    printf("[I] Merging %zu profiles (round %zu)" _endl, count, round + 1);
+    fflush(stdout);
+    for (size_t pair = 0; pair < pairs; pair++) {
+
+      char* const merged = (char*)calloc(strlen(directories[pair * 2]) + 32, 1);
+      sprintf(merged, "%s.%zu", directories[pair * 2], round);
+      commands[pair] = (char*)calloc(strlen(gcov_tool) + strlen(merged) + strlen(directories[pair * 2]) + strlen(directories[pair * 2 + 1]) + 16, 1);
+      sprintf(commands[pair], "%s merge -o %s %s %s", gcov_tool, merged, directories[pair * 2], directories[pair * 2 + 1]);
+      free(directories[pair * 2]);
+      free(directories[pair * 2 + 1]);
+      directories[pair] = merged;
+    }
+    __run_jobs(jobs < pairs ? jobs : pairs, pairs, commands, commands, statuses, NULL, &__execute_commands);
+    for (size_t pair = 0; pair < pairs; pair++) {
+
+      status |= statuses[pair];
+      free(commands[pair]);
+    }
+    if (count % 2) directories[pairs] = directories[count - 1];
+    count = pairs + count % 2;
+  }
+  free(statuses);
+  free(commands);
+  if (status && count) free(directories[0]);
+  return status || !count ? NULL : directories[0];
+}
+
+
+static int __report_coverage(
+  const int jobs,
+  const int srcc,
+  const char* const srcv[],
+  char** const data_files,
+  const char* const profile
+) {
+
+  m8_cache_t cache = __cache_load("coverage");
+  unsigned long long* const hashes = (unsigned long long*)calloc(srcc, sizeof *hashes);
+  char** const commands = (char**)calloc(srcc, sizeof *commands);
+  char** const reports = __get_build_files(srcc, srcv, "gcov.txt");
+  int* const statuses = (int*)calloc(srcc, sizeof *statuses);
+  size_t stale_count = 0, * const stale_sources = (size_t*)calloc(srcc, sizeof *stale_sources);
+  for (size_t index = 0; index < srcc; index++) {
+
+    // Notes (`.gcno`) describe the source mapping, counters (`.gcda`) come from the merged profile.
+    char path[512] = { 0 };
+    sprintf(path, "%s" __path_delim "%s", profile, data_files[index]);
+    FILE* const file = fopen(path, "rb");
+    if (!file) continue;
+    fclose(file);
+    if (__copy(path, data_files[index]) != 0) continue;
+    strcpy(path, data_files[index]);
+    strcpy(strrchr(path, '.'), ".gcno");
+    unsigned long long hash = __hash_string(__hash_seed, srcv[index]), cached_hash = 0;
+    __hash_gcov_file(&hash, path);
+    __hash_gcov_file(&hash, data_files[index]);
+    hashes[index] = hash;
+    if (__cache_get(&cache, srcv[index], &cached_hash) && cached_hash == hash) continue;
+    commands[stale_count] = (char*)calloc(strlen(gcov) + strlen(path) + strlen(reports[index]) + 16, 1);
+    sprintf(commands[stale_count], "%s -b -n %s > %s", gcov, path, reports[index]);
+    stale_sources[stale_count++] = index;
+  }
+  const int threads_count = jobs < stale_count ? jobs : stale_count;
+  printf("[I] Processing %zu of %d sources using %d jobs" _endl, stale_count, srcc, threads_count);
+  fflush(stdout);
+  if (stale_count) __run_jobs(threads_count, stale_count, commands, commands, statuses, NULL, &__execute_commands);
+
+  int status = 0;
+  char key[512], line[4096], expected_file[512];
+  for (size_t stale_id = 0; stale_id < stale_count; stale_id++) {
+
+    // Output has a block per file, headers included: `File '<path>'`, `Lines executed:P% of N`, ...
+    const size_t index = stale_sources[stale_id];
+    unsigned long long lines = 0, branches = 0;
+    bool inside = false;
+    sprintf(expected_file, "File '%s" __path_delim "%s'", source_dir, srcv[index]);
+    FILE* const file = statuses[stale_id] ? NULL : fopen(reports[index], "r");
+    while (file && fgets(line, sizeof line, file)) {
+
+      double percent = 0;
+      unsigned long long total = 0;
+      line[strcspn(line, "\r\n")] = '\0';
+      if (strncmp(line, "File '", 6) == 0) inside = strcmp(line, expected_file) == 0;
+      else if (inside && sscanf(line, "Lines executed:%lf%% of %llu", &percent, &total) == 2)
+        lines = ((unsigned long long)(percent * total / 100 + 0.5) << 32) | total;
+      else if (inside && sscanf(line, "Taken at least once:%lf%% of %llu", &percent, &total) == 2)
+        branches = ((unsigned long long)(percent * total / 100 + 0.5) << 32) | total;
+    }
+    if (file) fclose(file);
+    remove(reports[index]);
+    if (!file) {
+
+      printf("[E] Unable to process coverage of %s." _endl, srcv[index]);
+      hashes[index] = 0;
+      status = 1;
+      continue;
+    }
+
+    // No block for the source (e.g. it was never linked into a test), nothing worth caching.
+    if (!lines) {
+
+      hashes[index] = 0;
+      continue;
+    }
+
+    // Hit and total counts are packed into a single cached value.
+    sprintf(key, "%s#lines", srcv[index]);
+    __cache_set(&cache, key, lines);
+    sprintf(key, "%s#branches", srcv[index]);
+    __cache_set(&cache, key, branches);
+    __cache_set(&cache, srcv[index], hashes[index]);
+  }
+
+  unsigned long long totals[4] = { 0 };
+  size_t measured = 0;
+  char lines_text[64], branches_text[64];
+  const char* const format = "[I] %-40s lines %s   branches %s" _endl;
+  printf("- - - [REPORT] - - - - - - - - - - - - -" _endl);
+  for (size_t index = 0; index < srcc; index++) {
+
+    unsigned long long lines = 0, branches = 0;
+    sprintf(key, "%s#lines", srcv[index]);
+    const bool found = hashes[index] && __cache_get(&cache, key, &lines);
+    sprintf(key, "%s#branches", srcv[index]);
+    if (!found || !__cache_get(&cache, key, &branches)) {
+
+      printf("[I] %-40s no data" _endl, srcv[index]);
+      continue;
+    }
+    const unsigned long long counts[4] = { lines >> 32, lines & 0xFFFFFFFFULL, branches >> 32, branches & 0xFFFFFFFFULL };
+    printf(format, srcv[index], __format_coverage(lines_text, counts[0], counts[1]), __format_coverage(branches_text, counts[2], counts[3]));
+    for (size_t count_id = 0; count_id < 4; count_id++) totals[count_id] += counts[count_id];
+    measured++;
+  }
+  printf(format, "Total", __format_coverage(lines_text, totals[0], totals[1]), __format_coverage(branches_text, totals[2], totals[3]));
+
+  // A run which measured nothing is a broken setup (no instrumented code ran), not full coverage.
+  if (!measured) {
+
+    printf("[E] No coverage data was collected for any source." _endl);
+    status = 1;
+  }
+  if (__cache_save(&cache)) printf("[E] Unable to save coverage results to %s." _endl, cache.path);
+  __cache_free(&cache);
+  for (size_t index = 0; index < stale_count; index++) free(commands[index]);
+  free(commands);
+  free(stale_sources);
+  free(statuses);
+  free(hashes);
+  __free_object_files(srcc, reports);
+  return status;
+}
+
+
+static char* __format_coverage(char* const buffer, const unsigned long long hit, const unsigned long long total) {
+
+  if (total) sprintf(buffer, "%6llu/%-6llu %5.1f%%", hit, total, 100.0 * hit / total);
+  else sprintf(buffer, "%6llu/%-6llu %6s", hit, total, "n/a");
+  return buffer;
+}
+
+
+static bool __hash_gcov_file(unsigned long long* const hash, const char* const path) {
+
+  // Magic, version and stamp, 4 bytes each.
+  FILE* const file = fopen(path, "rb");
+  if (!file) return false;
+  char buffer[16384];
+  size_t size = 0;
+  fseek(file, 12, SEEK_SET);
+  while ((size = fread(buffer, 1, sizeof buffer, file)) > 0)
+    *hash = __hash_bytes(*hash, buffer, size);
+  fclose(file);
+  return true;
+}
+#endif
+
+
+static bool __has_option(const int argc, const char* const argv[], const char* const option) {
+
+  for (int index = 1; index < argc; index++)
+    if (strcmp(option, argv[index]) == 0) return true;
+  return false;
+}
+
+
+static unsigned long long __hash_bytes(unsigned long long hash, const void* const data, const size_t size) {
+
+  const unsigned char* const bytes = (const unsigned char*)data;
+  for (size_t index = 0; index < size; index++) {
+
+    hash ^= bytes[index];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+
+static unsigned long long __hash_string(const unsigned long long hash, const char* const string) {
+
+  return __hash_bytes(hash, string, strlen(string) + 1);
+}
+
+
+static bool __hash_file(unsigned long long* const hash, const char* const path) {
+
+  FILE* const file = fopen(path, "rb");
+  if (!file) {
+
+    *hash = __hash_string(*hash, "<missing>");
+    return false;
+  }
+  char buffer[16384];
+  size_t size = 0;
+  while ((size = fread(buffer, 1, sizeof buffer, file)) > 0)
+    *hash = __hash_bytes(*hash, buffer, size);
+  fclose(file);
+  return true;
+}
+
+
+static m8_cache_t __cache_load(const char* const name) {
+
+  m8_cache_t cache = { 0 };
+  const char* const directory = cache_dir ? cache_dir : build_dir;
+  mkdir(directory, 0755);
+  cache.path = (char*)calloc(strlen(directory) + strlen(name) + 10, 1);
+  sprintf(cache.path, "%s" __path_delim "%s.m8cache", directory, name);
+
+  FILE* const file = fopen(cache.path, "r");
+  if (!file) return cache;
+  char line[4096];
+  while (fgets(line, sizeof line, file)) {
+
+    unsigned long long value = 0;
+    int offset = 0;
+    line[strcspn(line, "\r\n")] = '\0';
+    if (sscanf(line, "%llx %n", &value, &offset) == 1 && line[offset]) __cache_set(&cache, line + offset, value);
+  }
+  fclose(file);
+  return cache;
+}
+
+
+static bool __cache_get(const m8_cache_t* const cache, const char* const key, unsigned long long* const value) {
+
+  for (size_t index = 0; index < cache->count; index++) {
+
+    if (strcmp(cache->keys[index], key) == 0) {
+
+      *value = cache->values[index];
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static void __cache_set(m8_cache_t* const cache, const char* const key, const unsigned long long value) {
+
+  for (size_t index = 0; index < cache->count; index++) {
+
+    if (strcmp(cache->keys[index], key) == 0) {
+
+      cache->values[index] = value;
+      return;
+    }
+  }
+  if (cache->count == cache->capacity) {
+
+    cache->capacity = cache->capacity ? cache->capacity * 2 : 64;
+    cache->keys = (char**)realloc(cache->keys, cache->capacity * sizeof *cache->keys);
+    cache->values = (unsigned long long*)realloc(cache->values, cache->capacity * sizeof *cache->values);
+  }
+  cache->keys[cache->count] = strcpy((char*)malloc(strlen(key) + 1), key);
+  cache->values[cache->count++] = value;
+  return;
+}
+
+
+static int __cache_save(const m8_cache_t* const cache) {
+
+  // Write to a temporary file first, so an interrupted run never leaves a truncated cache.
+  char* const temporary = (char*)calloc(strlen(cache->path) + 5, 1);
+  sprintf(temporary, "%s.tmp", cache->path);
+  FILE* const file = fopen(temporary, "w");
+  if (!file) {
+
+    free(temporary);
+    return -1;
+  }
+  for (size_t index = 0; index < cache->count; index++)
+    fprintf(file, "%016llx %s\n", cache->values[index], cache->keys[index]);
+  fclose(file);
+  #ifdef _WIN32
+    remove(cache->path);
+  #endif
+  const int status = rename(temporary, cache->path);
+  free(temporary);
+  return status;
+}
+
+
+static void __cache_free(m8_cache_t* const cache) {
+
+  for (size_t index = 0; index < cache->count; index++)
+    free(cache->keys[index]);
+  free(cache->keys);
+  free(cache->values);
+  free(cache->path);
+  *cache = (m8_cache_t){ 0 };
+  return;
+}
+
+
+#ifndef _WIN32
+static unsigned long long __hash_sources_state(const int srcc, const char* const srcv[]) {
+
+  unsigned long long hash = __hash_seed;
+  char path[512] = { 0 };
+  struct stat status;
+  for (size_t index = 0; index < srcc + header_files_count; index++) {
+
+    sprintf(path, "%s" __path_delim "%s", source_dir, index < srcc ? srcv[index] : header_files[index - srcc]);
+    if (stat(path, &status) != 0) memset(&status, 0, sizeof status);
+    hash = __hash_bytes(hash, &status.st_mtime, sizeof status.st_mtime);
+    hash = __hash_bytes(hash, &status.st_size, sizeof status.st_size);
+    hash = __hash_bytes(hash, &status.st_ino, sizeof status.st_ino);
+  }
+  return hash;
+}
+#endif
+
+
+#ifndef _WIN32
+static char** __disassemble(
+  const char* const source,
+  const char* const arguments,
+  const char* const symbol,
+  const char* const object,
+  size_t* const count
+) {
+
+  char* const command = (char*)malloc(8192);
+  sprintf(command, "%s %s -g -o %s %s" __path_delim "%s", compiler, arguments, object, source_dir, source);
+  printf("[I] Executing: %s" _endl, command);
+  fflush(stdout);
+  if (system(command)) {
+
+    printf("[E] Compilation failed." _endl);
+    free(command);
+    return NULL;
+  }
+  sprintf(command, "%s -d -C -S --no-show-raw-insn %s", objdump, object);
+  FILE* const pipe = popen(command, "r");
+  free(command);
+  if (!pipe) return NULL;
+
+  size_t capacity = 256;
+  char** lines = (char**)malloc(capacity * sizeof *lines);
+  char line[4096];
+  bool printing = false;
+  *count = 0;
+  while (fgets(line, sizeof line, pipe)) {
+
+    line[strcspn(line, "\r\n")] = '\0';
+
+    // Function headers look like `0000000000000000 <name(args)>:`.
+    char* const name = strstr(line, " <");
+    const size_t length = strlen(line);
+    if (name && length > 2 && line[length - 2] == '>' && line[length - 1] == ':') {
+
+      const char* const demangled = name + 2;
+      const size_t symbol_length = symbol ? strlen(symbol) : 0;
+      printing = !symbol || (strncmp(demangled, symbol, symbol_length) == 0 && strchr("(<>", demangled[symbol_length]));
+    } else if (strncmp(line, "Disassembly of section", 22) == 0) {
+
+      printing = false;
+      if (!symbol) printing = true;
+    }
+    if (!printing || (!symbol && !*count && !*line)) continue;
+
+    char expanded[8192];
+    size_t position = 0;
+    for (const char* symbol_char = line; *symbol_char && position < sizeof expanded - 9; symbol_char++) {
+
+      if (*symbol_char == '\t') do expanded[position++] = ' '; while (position % 8);
+      else expanded[position++] = *symbol_char;
+    }
+    expanded[position] = '\0';
+    if (*count == capacity) lines = (char**)realloc(lines, (capacity *= 2) * sizeof *lines);
+    lines[(*count)++] = strcpy((char*)malloc(position + 1), expanded);
+  }
+  pclose(pipe);
+  return lines;
+}
+#endif
+
+
+#ifdef __linux__
+static int __open_counter(const m8_counter_t* const counter, const pid_t pid, const bool exec) {
+
+  struct perf_event_attr attributes;
+  memset(&attributes, 0, sizeof attributes);
+  attributes.size = sizeof attributes;
+  attributes.type = counter->type;
+  attributes.config = counter->config;
+  attributes.disabled = exec;
+  attributes.enable_on_exec = exec;
+  attributes.inherit = 1;
+
+  // Hardware events share a few PMU registers and get multiplexed, enabled and running times allow scaling.
+  attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // Kernel events require privileges on most hosts (`perf_event_paranoid`).
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  return (int)syscall(__NR_perf_event_open, &attributes, pid, -1, -1, 0);
+}
+
+
+static int __run_measured(
+  const char* const command,
+  const m8_counter_t* const counters,
+  const size_t count,
+  unsigned long long* const values,
+  double* const seconds
+) {
+
+  // The child waits until counters are attached, they start counting on `exec`.
+  int ready[2];
+  if (pipe(ready)) return -1;
+  const double started = __now();
+  const pid_t pid = fork();
+  if (pid == 0) {
+
+    char signal = 0;
+    close(ready[1]);
+    if (read(ready[0], &signal, 1) < 0) _exit(127);
+    close(ready[0]);
+    execl("/bin/sh", "sh", "-c", command, (char*)NULL);
+    _exit(127);
+  }
+  close(ready[0]);
+  int* const descriptors = (int*)calloc(count, sizeof *descriptors);
+  for (size_t counter_id = 0; pid > 0 && counter_id < count; counter_id++)
+    descriptors[counter_id] = __open_counter(counters + counter_id, pid, true);
+  close(ready[1]);
+
+  int status = -1;
+  if (pid > 0 && waitpid(pid, &status, 0) != pid) status = -1;
+  *seconds = __now() - started;
+  for (size_t counter_id = 0; pid > 0 && counter_id < count; counter_id++) {
+
+    // Value, time enabled and time running. A counter which was never scheduled has no estimate.
+    unsigned long long sample[3] = { 0 };
+    values[counter_id] = ~0ULL;
+    if (descriptors[counter_id] < 0) continue;
+    if (read(descriptors[counter_id], sample, sizeof sample) == sizeof sample && sample[2])
+      values[counter_id] = sample[2] < sample[1] ? (unsigned long long)((long double)sample[0] * sample[1] / sample[2]) : sample[0];
+    close(descriptors[counter_id]);
+  }
+  free(descriptors);
+  return status;
+}
+#endif
+
+
+static double __now(void) {
+
+  #ifdef _WIN32
+    return GetTickCount64() / 1000.0;
+  #else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+  #endif
+}
+
+
+static bool __print_file(const char* const path) {
+
+  FILE* const file = fopen(path, "r");
+  if (!file) return false;
+  char buffer[4096];
+  size_t size = 0;
+  bool printed = false;
+  while ((size = fread(buffer, 1, sizeof buffer, file)) > 0) {
+
+    fwrite(buffer, 1, size, stdout);
+    printed = true;
+  }
+  fclose(file);
+  return printed;
+}
+
+
+#ifdef __linux__
+static void __start_monitor(const int jobs, const int srcc, char** const srcv, const m8_cache_t* const times) {
+
+  __monitor.slots = (m8_job_slot_t*)calloc(jobs, sizeof *__monitor.slots);
+  __monitor.expected = (double*)calloc(srcc, sizeof *__monitor.expected);
+  __monitor.slots_count = jobs;
+  __monitor.srcv = srcv;
+  __monitor.total = srcc;
+  __monitor.done = __monitor.started_count = __monitor.pending_unknown = 0;
+  __monitor.done_time = __monitor.pending_expected = 0;
+  for (size_t index = 0; index < srcc; index++) {
+
+    unsigned long long milliseconds = 0;
+    if (__cache_get(times, srcv[index], &milliseconds)) __monitor.expected[index] = milliseconds / 1000.0;
+    if (__monitor.expected[index] > 0) __monitor.pending_expected += __monitor.expected[index];
+    else __monitor.pending_unknown++;
+  }
+  __monitor.started = __now();
+  __monitor.running = true;
+  return;
+}
+
+
+static void __stop_monitor(void) {
+
+  free(__monitor.slots);
+  free(__monitor.expected);
+  __monitor.slots = NULL;
+  __monitor.expected = NULL;
+  return;
+}
+
+
+static thread_return_t __monitor_jobs(const thread_arg_t data) {
+
+  const long page_size = sysconf(_SC_PAGESIZE), ticks_per_second = sysconf(_SC_CLK_TCK);
+  const size_t slots_count = __monitor.slots_count;
+  m8_job_slot_t* const slots = (m8_job_slot_t*)calloc(slots_count, sizeof *slots);
+  unsigned long* const previous_ticks = (unsigned long*)calloc(slots_count, sizeof *previous_ticks);
+  pid_t* const previous_pids = (pid_t*)calloc(slots_count, sizeof *previous_pids);
+  unsigned long* const ticks = (unsigned long*)calloc(slots_count, sizeof *ticks);
+  long* const pages = (long*)calloc(slots_count, sizeof *pages);
+  size_t processes_capacity = 256, drawn_lines = 0;
+  m8_process_t* processes = (m8_process_t*)malloc(processes_capacity * sizeof *processes);
+  double previous_time = __now();
+  const struct timespec interval = { 0, 250000000L };
+  bool running = true;
+  printf("\x1b[?25l");
+
+  while (running) {
+
+    // Copy the state under the lock, everything else runs without blocking workers.
+    pthread_mutex_lock(&__monitor.lock);
+    running = __monitor.running;
+    memcpy(slots, __monitor.slots, slots_count * sizeof *slots);
+    const size_t total = __monitor.total, done = __monitor.done, started_count = __monitor.started_count;
+    const size_t pending_unknown = __monitor.pending_unknown;
+    const double done_time = __monitor.done_time, pending_expected = __monitor.pending_expected, build_started = __monitor.started;
+    pthread_mutex_unlock(&__monitor.lock);
+
+    // Snapshot all processes, compilers spawn children (cc1, as, ld) which do the actual work.
+    size_t processes_count = 0;
+    DIR* const proc = opendir("/proc");
+    struct dirent* entry = NULL;
+    while (proc && (entry = readdir(proc))) {
+
+      if (*entry->d_name < '0' || *entry->d_name > '9') continue;
+      char path[300], line[1024];
+      snprintf(path, sizeof path, "/proc/%s/stat", entry->d_name);
+      FILE* const file = fopen(path, "r");
+      if (!file) continue;
+      const bool read_line = fgets(line, sizeof line, file) != NULL;
+      fclose(file);
+      const char* const fields = read_line ? strrchr(line, ')') : NULL;
+      if (!fields) continue;
+      m8_process_t process = { .pid = (pid_t)atoi(entry->d_name) };
+      unsigned long user_ticks = 0, system_ticks = 0;
+      if (sscanf(fields + 1, " %*c %d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %*d %*d %*d %*d %*d %*d %*u %*u %ld",
+                 &process.parent, &user_ticks, &system_ticks, &process.pages) != 4) continue;
+      process.ticks = user_ticks + system_ticks;
+      if (processes_count == processes_capacity)
+        processes = (m8_process_t*)realloc(processes, (processes_capacity *= 2) * sizeof *processes);
+      processes[processes_count++] = process;
+    }
+    if (proc) closedir(proc);
+
+    // Every process is attributed once: walk up its parents (indexed by pid) until a slot's compiler is found.
+    qsort(processes, processes_count, sizeof *processes, &__compare_processes);
+    memset(ticks, 0, slots_count * sizeof *ticks);
+    memset(pages, 0, slots_count * sizeof *pages);
+    for (size_t index = 0; index < processes_count; index++) {
+
+      const m8_process_t* ancestor = processes + index;
+      for (size_t depth = 0; depth < 8 && ancestor && ancestor->pid > 1; depth++) {
+
+        size_t slot = 0;
+        while (slot < slots_count && (!slots[slot].source || slots[slot].pid != ancestor->pid)) slot++;
+        if (slot < slots_count) {
+
+          ticks[slot] += processes[index].ticks;
+          pages[slot] += processes[index].pages;
+          break;
+        }
+        const m8_process_t key = { .pid = ancestor->parent };
+        ancestor = (const m8_process_t*)bsearch(&key, processes, processes_count, sizeof *processes, &__compare_processes);
+      }
+    }
+
+    const double now = __now(), period = now - previous_time > 0 ? now - previous_time : 1;
+    previous_time = now;
+    const double average = done ? done_time / done : (total > pending_unknown ? pending_expected / (total - pending_unknown) : 1);
+    double remaining = pending_expected + pending_unknown * average;
+    size_t running_count = 0;
+
+    if (drawn_lines) printf("\x1b[%zuA\x1b[J", drawn_lines);
+    drawn_lines = slots_count + 2;
+    printf("%-4s %-40s %9s %9s %6s %9s" _endl, "JOB", "SOURCE", "ELAPSED", "EXPECTED", "CPU", "RSS");
+    for (size_t slot = 0; slot < slots_count; slot++) {
+
+      if (!slots[slot].source) {
+
+        printf("%-4zu %-40s" _endl, slot, "(idle)");
+        continue;
+      }
+      running_count++;
+      const unsigned long ticks_delta = previous_pids[slot] == slots[slot].pid && ticks[slot] >= previous_ticks[slot]
+                                        ? ticks[slot] - previous_ticks[slot] : 0;
+      previous_pids[slot] = slots[slot].pid;
+      previous_ticks[slot] = ticks[slot];
+
+      const double elapsed = now - slots[slot].started, expected = slots[slot].expected > 0 ? slots[slot].expected : average;
+      remaining += expected > elapsed ? expected - elapsed : 0;
+      const size_t length = strlen(slots[slot].source);
+      char expected_text[32] = "?";
+      if (slots[slot].expected > 0) snprintf(expected_text, sizeof expected_text, "%.1fs", slots[slot].expected);
+      printf("%-4zu %-40s %8.1fs %9s %5.0f%% %8.1fM" _endl, slot,
+             length > 40 ? slots[slot].source + length - 40 : slots[slot].source, elapsed, expected_text,
+             100.0 * ticks_delta / ticks_per_second / period, (double)pages[slot] * page_size / (1024 * 1024));
+    }
+    printf("[I] Done %zu/%zu, running %zu, queued %zu, elapsed %.1fs, ETA %.1fs" _endl,
+           done, total, running_count, total - started_count, now - build_started, remaining > 0 ? remaining / slots_count : 0);
+    fflush(stdout);
+    if (running) nanosleep(&interval, NULL);
+  }
+  printf("\x1b[?25h");
+  fflush(stdout);
+  free(processes);
+  free(pages);
+  free(ticks);
+  free(previous_pids);
+  free(previous_ticks);
+  free(slots);
+  return 0;
+}
+
+
+static int __compare_processes(const void* const left, const void* const right) {
+
+  const pid_t left_pid = ((const m8_process_t*)left)->pid, right_pid = ((const m8_process_t*)right)->pid;
+  return (left_pid > right_pid) - (left_pid < right_pid);
+}
+
+
+static int __execute_job(const char* const command, const char* const object, const char* const source, const size_t slot) {
+
+  char log[512] = { 0 };
+  sprintf(log, "%s.log", object);
+  pthread_mutex_lock(&__monitor.lock);
+  double expected = 0;
+  for (size_t index = 0; index < __monitor.total; index++)
+    if (__monitor.srcv[index] == source) expected = __monitor.expected[index];
+  if (expected > 0) __monitor.pending_expected -= expected;
+  else if (__monitor.pending_unknown) __monitor.pending_unknown--;
+  __monitor.started_count++;
+  __monitor.slots[slot] = (m8_job_slot_t){ .source = source, .started = __now(), .expected = expected };
+  pthread_mutex_unlock(&__monitor.lock);
+
+  int status = -1;
+  const pid_t pid = fork();
+  if (pid == 0) {
+
+    const int file = open(log, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file >= 0) {
+
+      dup2(file, STDOUT_FILENO);
+      dup2(file, STDERR_FILENO);
+      close(file);
+    }
+    execl("/bin/sh", "sh", "-c", command, (char*)NULL);
+    _exit(127);
+  }
+  if (pid > 0) {
+
+    pthread_mutex_lock(&__monitor.lock);
+    __monitor.slots[slot].pid = pid;
+    pthread_mutex_unlock(&__monitor.lock);
+    if (waitpid(pid, &status, 0) != pid) status = -1;
+  }
+
+  pthread_mutex_lock(&__monitor.lock);
+  __monitor.done_time += __now() - __monitor.slots[slot].started;
+  __monitor.done++;
+  __monitor.slots[slot].source = NULL;
+  pthread_mutex_unlock(&__monitor.lock);
+  return status;
+}
+#endif
+
+
+// Preloaded library, which records every file opened by a traced job.
+static const char* const __trace_shim_source =
+  "#define _GNU_SOURCE\n"
+  "#include <dlfcn.h>\n"
+  "#include <fcntl.h>\n"
+  "#include <limits.h>\n"
+  "#include <stdarg.h>\n"
+  "#include <stdio.h>\n"
+  "#include <stdlib.h>\n"
+  "#include <string.h>\n"
+  "#include <unistd.h>\n"
+  "static void m8_record(int directory, const char* path, int writes) {\n"
+  "  static int (*real_open)(const char*, int, ...) = 0;\n"
+  "  const char* trace = getenv(\"M8_TRACE\");\n"
+  "  char base[PATH_MAX] = { 0 }, line[2 * PATH_MAX + 8];\n"
+  "  if (!trace || !path) return;\n"
+  "  if (!real_open) real_open = (int(*)(const char*, int, ...))dlsym(RTLD_NEXT, \"open\");\n"
+  "  if (*path != '/') {\n"
+  "    if (directory == AT_FDCWD) { if (!getcwd(base, sizeof base)) return; }\n"
+  "    else {\n"
+  "      char link[64];\n"
+  "      snprintf(link, sizeof link, \"/proc/self/fd/%d\", directory);\n"
+  "      if (readlink(link, base, sizeof base - 1) < 0) return;\n"
+  "    }\n"
+  "  }\n"
+  "  const int length = snprintf(line, sizeof line, \"%c %s%s%s\\n\", writes ? 'W' : 'R', base, *base ? \"/\" : \"\", path);\n"
+  "  if (length <= 0 || length >= (int)sizeof line) return;\n"
+  "  const int file = real_open(trace, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);\n"
+  "  if (file < 0) return;\n"
+  "  if (write(file, line, length) < 0) {}\n"
+  "  close(file);\n"
+  "}\n"
+  "#define M8_WRITES(flags) (((flags) & O_ACCMODE) != O_RDONLY || ((flags) & (O_CREAT | O_TRUNC)))\n"
+  "#define M8_OPEN(parameters, name, directory, ...) \\\n"
+  "  mode_t mode = 0; \\\n"
+  "  if (flags & (O_CREAT | O_TMPFILE)) { va_list list; va_start(list, flags); mode = va_arg(list, int); va_end(list); } \\\n"
+  "  static int (*real)parameters = 0; \\\n"
+  "  if (!real) real = (int(*)parameters)dlsym(RTLD_NEXT, name); \\\n"
+  "  m8_record(directory, path, M8_WRITES(flags)); \\\n"
+  "  return real(__VA_ARGS__, mode);\n"
+  "int open(const char* path, int flags, ...) { M8_OPEN((const char*, int, ...), \"open\", AT_FDCWD, path, flags) }\n"
+  "int open64(const char* path, int flags, ...) { M8_OPEN((const char*, int, ...), \"open64\", AT_FDCWD, path, flags) }\n"
+  "int openat(int at, const char* path, int flags, ...) { M8_OPEN((int, const char*, int, ...), \"openat\", at, at, path, flags) }\n"
+  "int openat64(int at, const char* path, int flags, ...) { M8_OPEN((int, const char*, int, ...), \"openat64\", at, at, path, flags) }\n"
+  "int __open_2(const char* path, int flags) { return open(path, flags); }\n"
+  "int __open64_2(const char* path, int flags) { return open64(path, flags); }\n"
+  "int __openat_2(int at, const char* path, int flags) { return openat(at, path, flags); }\n"
+  "int __openat64_2(int at, const char* path, int flags) { return openat64(at, path, flags); }\n"
+  "int creat(const char* path, mode_t mode) { return open(path, O_CREAT | O_WRONLY | O_TRUNC, mode); }\n"
+  "int creat64(const char* path, mode_t mode) { return open64(path, O_CREAT | O_WRONLY | O_TRUNC, mode); }\n"
+  "#define M8_FOPEN(name) \\\n"
+  "  static FILE* (*real)(const char*, const char*) = 0; \\\n"
+  "  if (!real) real = (FILE*(*)(const char*, const char*))dlsym(RTLD_NEXT, name); \\\n"
+  "  m8_record(AT_FDCWD, path, mode && strpbrk(mode, \"wa+\") != 0); \\\n"
+  "  return real(path, mode);\n"
+  "FILE* fopen(const char* path, const char* mode) { M8_FOPEN(\"fopen\") }\n"
+  "FILE* fopen64(const char* path, const char* mode) { M8_FOPEN(\"fopen64\") }\n";
+
+
+static int __execute_traced(const char* const command, const char* const trace) {
+
+  #ifdef __linux__
+    char library[1024] = { 0 }, source[512] = { 0 }, buffer[2048] = { 0 }, directory[512] = { 0 };
+    if (!getcwd(directory, sizeof directory)) return system(command);
+    sprintf(source, "%s" __path_delim "m8trace.c", build_dir);
+    sprintf(library, "%s" __path_delim "%s" __path_delim "m8trace.so", directory, build_dir);
+
+    FILE* const file = fopen(library, "rb");
+    if (file) fclose(file);
+    else {
+
+      FILE* const source_file = fopen(source, "w");
+      if (source_file) {
+
+        fputs(__trace_shim_source, source_file);
+        fclose(source_file);
+      }
+      sprintf(buffer, "%s -shared -fPIC -o %s %s -ldl", __cc, library, source);
+      printf("[I] Building tracing library: %s" _endl, buffer);
+      fflush(stdout);
+      if (system(buffer)) {
+
+        printf("[E] Unable to build tracing library, running untraced." _endl);
+        return system(command);
+      }
+    }
+
+    // The trace path must stay valid if the job changes its working directory.
+    sprintf(buffer, "%s" __path_delim "%s", directory, trace);
+    const char* const preload = getenv("LD_PRELOAD");
+    char* const previous_preload = preload ? strcpy((char*)malloc(strlen(preload) + 1), preload) : NULL;
+    setenv("M8_TRACE", buffer, 1);
+    setenv("LD_PRELOAD", library, 1);
+    const int status = system(command);
+    if (previous_preload) setenv("LD_PRELOAD", previous_preload, 1);
+    else unsetenv("LD_PRELOAD");
+    unsetenv("M8_TRACE");
+    free(previous_preload);
+    return status;
+  #else
+    printf("[W] Command tracing is not supported on this host, running untraced." _endl);
+    return system(command);
+  #endif
+}
+
+
+static bool __read_trace(const char* const trace, m8_cache_t* const files) {
+
+  #ifdef __linux__
+    char directory[512] = { 0 }, line[8192];
+    if (!getcwd(directory, sizeof directory)) return false;
+    const size_t directory_length = strlen(directory);
+    FILE* const file = fopen(trace, "r");
+    if (!file) return false;
+    while (fgets(line, sizeof line, file)) {
+
+      line[strcspn(line, "\r\n")] = '\0';
+      const char* path = line + 2;
+      if ((line[0] != 'R' && line[0] != 'W') || line[1] != ' ') continue;
+      if (strncmp(path, directory, directory_length) != 0 || path[directory_length] != '/') continue;
+      path += directory_length + 1;
+      while (path[0] == '.' && path[1] == '/') path += 2;
+
+      // Skip directories and files, which did not survive the job (e.g. temporary ones).
+      struct stat status;
+      if (stat(path, &status) != 0 || S_ISDIR(status.st_mode)) continue;
+      unsigned long long access = 0;
+      __cache_get(files, path, &access);
+      __cache_set(files, path, line[0] == 'W' ? 2 : (access ? access : 1));
+    }
+    fclose(file);
+    return true;
+  #else
+    return false;
+  #endif
+}
+
 #endif